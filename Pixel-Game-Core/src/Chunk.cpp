@@ -4,6 +4,7 @@
 #include "Pyxis/Game/PhysicsBody2D.h"
 #include "Pyxis/Renderer/Renderer2D.h"
 #include "VectorHash.h"
+#include <atomic>
 /*
 //create a static body for the chunk
                 float RBToWorld = (CHUNKSIZEF / PPU);
@@ -12,33 +13,98 @@ b2_staticBody); m_OwnedChainBody2D->SetPosition({ m_ChunkPos.x, m_ChunkPos.y });
 */
 
 namespace Pyxis {
-Chunk::Chunk(glm::ivec2 chunkPos) {
-    m_ChunkPos = chunkPos;
+void ChunkPlanes::ClearPlanes() {
+    Element empty;
     for (int i = 0; i < CHUNKSIZE * CHUNKSIZE; i++) {
-        m_Elements[i] = Element();
+        GetElement(i) = empty;
     }
+}
+
+Chunk::Chunk(glm::ivec2 chunkPos) {
     for (int x = 0; x < 64; x++) {
         m_BitArray.push_back(0);
     }
 
+    Reset(chunkPos);
+}
+
+Chunk::~Chunk() { Unlink(); }
+
+void Chunk::Reset(glm::ivec2 chunkPos) {
+    Unlink();
+    m_ChunkPos = chunkPos;
+    m_Neighbors[4] = this;
+
+    ClearPlanes();
+    std::fill(m_BitArray.begin(), m_BitArray.end(), 0);
+
     // reset dirty rect
     ResetDirtyRect();
-
-    m_Texture = Texture2D::Create(CHUNKSIZE, CHUNKSIZE);
-    // set texture to fill color
+    m_PersistDirtyRect = false;
+    m_MeshGenerated = false;
+    m_MeshChanged = true;
+    m_Awake = false;
+    m_MeshedBitArray.clear();
+    m_Quads.clear();
+    m_QuadShapes.clear();
+
+    // the texture is left alone, the world fills the whole of it in once
+    // the chunk is inserted
     std::fill(m_PixelBuffer, m_PixelBuffer + (CHUNKSIZE * CHUNKSIZE),
               0xFF000000);
-    m_Texture->SetData(m_PixelBuffer, sizeof(m_PixelBuffer));
+}
+
+void Chunk::CreateTexture() {
+    if (!m_Texture)
+        m_Texture = Texture2D::Create(CHUNKSIZE, CHUNKSIZE);
+}
+
+void Chunk::EnablePhysicsBody() {
+    glm::vec2 position = (glm::vec2(m_ChunkPos) * CHUNKSIZEF) * (1 / PPU);
+    // the body is gone if the physics world was remade while pooled
+    if (m_PhysicsBody && m_PhysicsBody->IsValid()) {
+        m_PhysicsBody->SetPosition(position);
+        m_PhysicsBody->SetEnabled(true);
+    } else {
+        PhysicsBody2DDef def;
+        def.type = PhysicsBody2DType::Static;
+        def.position = position;
+        m_PhysicsBody = Physics2D::GetWorld().CreateBody(def);
+    }
+    m_MeshGenerated = false;
+    m_MeshChanged = true;
+}
+
+void Chunk::DisablePhysicsBody() {
+    if (m_PhysicsBody && m_PhysicsBody->IsValid()) {
+        m_PhysicsBody->RemoveShapes();
+        m_PhysicsBody->SetEnabled(false);
+    }
+    m_MeshGenerated = false;
+    m_QuadShapes.clear();
+    m_Quads.clear();
+}
 
-    PhysicsBody2DDef def;
-    def.type = PhysicsBody2DType::Static;
-    def.position = (glm::vec2(m_ChunkPos) * CHUNKSIZEF) * (1 / PPU);
-    m_PhysicsBody = Physics2D::GetWorld().CreateBody(def);
+void Chunk::DestroyPhysicsBody() {
+    // the body removes itself and its shapes from the physics world
+    m_PhysicsBody.reset();
+    m_MeshGenerated = false;
+    m_QuadShapes.clear();
+    m_Quads.clear();
+}
+
+void Chunk::Unlink() {
+    for (int dy = -1; dy <= 1; dy++) {
+        for (int dx = -1; dx <= 1; dx++) {
+            if (dx != 0 || dy != 0)
+                SetNeighbor(dx, dy, nullptr);
+        }
+    }
 }
 
 void Chunk::Clear() {
     for (int i = 0; i < CHUNKSIZE * CHUNKSIZE; i++) {
-        m_Elements[i] = Element();
+        GetElement(i) = Element();
     }
 
     ResetDirtyRect();
@@ -46,47 +112,70 @@ void Chunk::Clear() {
     UpdateTexture();
 }
 
-Element &Chunk::GetElement(int x, int y) {
-    return m_Elements[x + y * CHUNKSIZE];
+ElementRef Chunk::GetElement(int x, int y) {
+    return GetElement(x + y * CHUNKSIZE);
 }
 
-Element &Chunk::GetElement(const glm::ivec2 &index) {
-    return m_Elements[index.x + index.y * CHUNKSIZE];
+ElementRef Chunk::GetElement(const glm::ivec2 &index) {
+    return GetElement(index.x + index.y * CHUNKSIZE);
+}
+ElementRef Chunk::GetElement(int index) {
+    return ChunkPlanes::GetElement(index);
 }
-Element &Chunk::GetElement(int index) { return m_Elements[index]; }
 
 void Chunk::SetElement(int x, int y, const Element &element) {
-    Element &currElement = m_Elements[x + y * CHUNKSIZE];
-    ElementProperties &currEP =
-        ElementData::GetElementProperties(currElement.m_ID);
+    ElementRef currElement = GetElement(x, y);
     bool currIsSolid = (!currElement.m_Rigid) &&
-                       (currEP.cell_type == ElementType::solid ||
-                        currEP.cell_type == ElementType::movableSolid);
-
-    ElementProperties newEP = ElementData::GetElementProperties(element.m_ID);
+                       ElementData::IsColliderSolid(currElement.m_ID);
     bool newIsSolid =
-        (!element.m_Rigid) && (newEP.cell_type == ElementType::solid ||
-                               newEP.cell_type == ElementType::movableSolid);
+        (!element.m_Rigid) && ElementData::IsColliderSolid(element.m_ID);
     // actually set the element now
-    m_Elements[x + y * CHUNKSIZE] = element;
+    currElement = element;
 
     if (currIsSolid != newIsSolid) {
         // mesh needs to be changed
-        m_MeshChanged = true;
+        MarkMeshChanged();
+        // the chunks above and below can both write into the same column
+        // while they update in parallel, so change the bit atomically.
+        std::atomic_ref<uint64_t> column(m_BitArray[x]);
         if (newIsSolid) {
             // set bit to 1
             uint64_t mask = 1u;
-            m_BitArray[x] |= (uint64_t)(mask << y);
+            column.fetch_or((uint64_t)(mask << y), std::memory_order_relaxed);
         } else {
             // set bit to 0
             uint64_t mask = 1u;
             uint64_t AndMask =
                 ~(mask << y); // inverse of 1 bitshifted to the position of y.
-            m_BitArray[x] &= AndMask;
+            column.fetch_and(AndMask, std::memory_order_relaxed);
         }
     } // else would mean that the collider wouldn't need to be updated.
 }
 
+void Chunk::UpdateBitArray() {
+    for (int x = 0; x < CHUNKSIZE; x++) {
+        uint64_t column = 0;
+        for (int y = 0; y < CHUNKSIZE; y++) {
+            int index = x + y * CHUNKSIZE;
+            bool rigid = m_Flags[index] & ElementFlag_Rigid;
+            if (!rigid && ElementData::IsColliderSolid(m_IDs[index]))
+                column |= (uint64_t)1 << y;
+        }
+        m_BitArray[x] = column;
+    }
+    m_MeshChanged = true;
+}
+
+void Chunk::SetNeighbor(int dx, int dy, Chunk *neighbor) {
+    Chunk *previous = GetNeighbor(dx, dy);
+    if (previous != nullptr && previous != neighbor)
+        previous->m_Neighbors[(-dx + 1) + (-dy + 1) * 3] = nullptr;
+
+    m_Neighbors[(dx + 1) + (dy + 1) * 3] = neighbor;
+    if (neighbor != nullptr)
+        neighbor->m_Neighbors[(-dx + 1) + (-dy + 1) * 3] = this;
+}
+
 /// <summary>
 /// updates the dirty rect for the chunk
 void Chunk::UpdateDirtyRect(int x, int y) {
@@ -102,6 +191,13 @@ void Chunk::UpdateDirtyRect(int x, int y) {
         m_DirtyRect.max.y = y + m_DirtyRectBorderWidth;
 }
 
+void Chunk::UpdateDirtyRectLocked(int x, int y) {
+    // growing the rect only ever takes the min / max, so the order that
+    // neighbors get here in doesn't change the result.
+    std::scoped_lock lock(m_DirtyRectMutex);
+    UpdateDirtyRect(x, y);
+}
+
 void Chunk::ResetDirtyRect() {
     m_DirtyRect.min.x = CHUNKSIZE - 1;
     m_DirtyRect.min.y = CHUNKSIZE - 1;
@@ -109,6 +205,12 @@ void Chunk::ResetDirtyRect() {
     m_DirtyRect.max.y = 0;
 }
 
+bool Chunk::IsSettled() const {
+    bool rectCollapsed = m_DirtyRect.min.x > m_DirtyRect.max.x ||
+                         m_DirtyRect.min.y > m_DirtyRect.max.y;
+    return rectCollapsed && !m_MeshChanged;
+}
+
 void Chunk::UpdateTexture() {
     bool dataChanged = false;
 
@@ -121,8 +223,7 @@ void Chunk::UpdateTexture() {
             // loop from min x to max x
             for (int y = std::max(m_DirtyRect.min.y, 0);
                  y <= std::min(m_DirtyRect.max.y, CHUNKSIZE - 1); y++) {
-                m_PixelBuffer[x + y * CHUNKSIZE] =
-                    m_Elements[x + y * CHUNKSIZE].m_Color;
+                m_PixelBuffer[x + y * CHUNKSIZE] = m_Colors[x + y * CHUNKSIZE];
             }
         }
     }
@@ -137,12 +238,7 @@ void Chunk::UpdateWholeTexture() {
     // set data first, then update the pixels. this allows you to draw over the
     // texture without interupting the actual elements in the map.
 
-    for (int x = 0; x < CHUNKSIZE; x++) {
-        for (int y = 0; y < CHUNKSIZE; y++) {
-            m_PixelBuffer[x + y * CHUNKSIZE] =
-                m_Elements[x + y * CHUNKSIZE].m_Color;
-        }
-    }
+    std::copy(m_Colors, m_Colors + (CHUNKSIZE * CHUNKSIZE), m_PixelBuffer);
     m_Texture->SetData(m_PixelBuffer, sizeof(m_PixelBuffer));
 }
 
@@ -180,69 +276,47 @@ void Chunk::RenderChunk() {
 }
 
 void Chunk::GenerateMesh() {
+    // only the columns from the first one that changed since the last mesh
+    // need meshing again. if the shapes we made are gone, like after the
+    // physics world was remade, start over.
+    size_t firstDirtyColumn = 0;
+    bool shapesValid = m_MeshGenerated && m_MeshedBitArray.size() == 64 &&
+                       std::all_of(m_QuadShapes.begin(), m_QuadShapes.end(),
+                                   [](b2ShapeId shape) {
+                                       return b2Shape_IsValid(shape);
+                                   });
+    if (shapesValid) {
+        firstDirtyColumn =
+            std::mismatch(m_BitArray.begin(), m_BitArray.end(),
+                          m_MeshedBitArray.begin())
+                .first -
+            m_BitArray.begin();
+    } else {
+        m_PhysicsBody->RemoveShapes();
+        m_Quads.clear();
+        m_QuadShapes.clear();
+    }
     m_MeshGenerated = true;
-    // convert bitmap to quads to add to body.
 
-    m_PhysicsBody->RemoveShapes();
-
-    auto quads = BinaryGreedyMesh(m_BitArray);
-    for (auto &quad : quads) {
-        glm::vec2 quadPosition = quad.center;
-        m_PhysicsBody->AddBoxShape(quad.halfWidth / PPU, quad.halfHeight / PPU,
-                                   quadPosition / PPU, 0);
-    }
+    // convert bitmap to quads to add to body.
+    m_PreviousQuads = m_Quads;
+    BinaryGreedyMesh(m_BitArray, m_Quads, firstDirtyColumn);
+    m_MeshedBitArray = m_BitArray;
+
+    UpdateBGMShapes(
+        m_PreviousQuads, m_Quads, m_QuadShapes,
+        [&](b2ShapeId shape) { m_PhysicsBody->RemoveShape(shape); },
+        [&](const BGMQuad &quad) {
+            glm::vec2 quadPosition = quad.center;
+            return m_PhysicsBody->AddBoxShape(quad.halfWidth / PPU,
+                                              quad.halfHeight / PPU,
+                                              quadPosition / PPU, 0);
+        });
     m_MeshChanged = false;
 }
 
 void Chunk::AddPreviousMesh() { m_MeshGenerated = true; }
 
-void Chunk::QueuePull(glm::ivec2 startPos,
-                      std::unordered_set<glm::ivec2, VectorHash> &result,
-                      std::unordered_set<glm::ivec2, VectorHash> &source) {
-    if (source.size() == 0)
-        return;
-
-    // make sure the start pos is valid
-    if (!source.contains(startPos)) {
-        startPos = *source.begin();
-    }
-
-    // we make a queue of positions to check
-    std::queue<glm::ivec2> queue;
-    std::unordered_set<glm::ivec2, VectorHash> visited;
-
-    queue.push(startPos);
-    visited.insert(startPos);
-    result.insert(startPos);
-    source.erase(
-        startPos); // since we know it is valid, and it won't be reached by loop
-
-    const glm::ivec2 neighbors[] = {
-        {1, 0},
-        {-1, 0},
-        {0, 1},
-        {0, -1},
-    };
-
-    while (queue.size() > 0) {
-        // check neighbors to see if we need to add them to the queue, or
-        // have already visited them
-        glm::ivec2 position = queue.front();
-        queue.pop();
-
-        for (int i = 0; i < 4; i++) {
-            glm::ivec2 pos = position + neighbors[i];
-            if (!visited.contains(pos) && source.contains(pos)) {
-                queue.push(pos);
-                result.insert(pos);
-                source.erase(pos);
-            }
-            visited.insert(pos);
-        }
-    }
-
-    // done!
-}
 int Chunk::GetMarchingSquareCase(
     const glm::ivec2 &localPosition,
     const std::unordered_set<glm::ivec2, VectorHash> &source) {
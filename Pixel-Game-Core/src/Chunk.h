@@ -3,8 +3,11 @@
 #include "Element.h"
 #include "VectorHash.h"
 #include <Pyxis.h>
+#include <Pyxis/Core/BinaryGreedyMesh.h>
 #include <Pyxis/Nodes/PhysicsBodyNode2D.h>
+#include <atomic>
 #include <box2d/box2d.h>
+#include <mutex>
 
 namespace Pyxis {
 struct DirtyRect {
@@ -12,26 +15,96 @@ struct DirtyRect {
     glm::ivec2 max = {0, 0};
 };
 
-class Chunk {
+/// <summary>
+/// Just the element planes of a chunk, with none of what the world needs to
+/// simulate or draw it, so terrain can be generated and compared without a
+/// texture, a physics body or a bit array.
+/// </summary>
+struct ChunkPlanes {
+    uint16_t m_IDs[CHUNKSIZE * CHUNKSIZE];
+    uint32_t m_BaseColors[CHUNKSIZE * CHUNKSIZE];
+    uint32_t m_Colors[CHUNKSIZE * CHUNKSIZE];
+    float m_Temperatures[CHUNKSIZE * CHUNKSIZE];
+    int32_t m_Healths[CHUNKSIZE * CHUNKSIZE];
+    int8_t m_Horizontals[CHUNKSIZE * CHUNKSIZE];
+    // ElementFlag bits
+    uint8_t m_Flags[CHUNKSIZE * CHUNKSIZE];
+
+    ElementRef GetElement(int index) {
+        return ElementRef(m_IDs[index], m_BaseColors[index], m_Colors[index],
+                          m_Temperatures[index], m_Healths[index],
+                          m_Horizontals[index], m_Flags[index]);
+    }
+    // sets only the planes, see Chunk::SetElement for the collider bits
+    void SetElement(int x, int y, const Element &element) {
+        GetElement(x + y * CHUNKSIZE) = element;
+    }
+    // fills every plane with the empty element
+    void ClearPlanes();
+};
+
+class Chunk : public ChunkPlanes {
   public:
     inline static bool s_DebugChunks = false;
 
     Chunk(glm::ivec2 chunkPos);
-    ~Chunk() = default;
+    // unlinks itself from its neighbors
+    ~Chunk();
 
     void Clear();
+    // puts a used chunk back into the state of a freshly constructed one at
+    // chunkPos, keeping its texture so the world can recycle it instead of
+    // allocating a new one. only the element data is touched, so chunks can
+    // be reset and generated without the renderer or the physics world.
+    void Reset(glm::ivec2 chunkPos);
+    // makes the texture if the chunk doesn't have one yet
+    void CreateTexture();
+    // moves the static body the collider is built on to the chunk and enables
+    // it, making it first if the chunk doesn't have one yet.
+    void EnablePhysicsBody();
+    // takes the collider off the body and disables it, so a pooled chunk
+    // keeps its body for next time without it being simulated
+    void DisablePhysicsBody();
+    // frees the body for good
+    void DestroyPhysicsBody();
+    // drops every link to and from the neighboring chunks
+    void Unlink();
 
     // Get an element from the chunk via x & y
-    Element &GetElement(int x, int y);
+    ElementRef GetElement(int x, int y);
     // Get an element from the chunk via vec2
-    Element &GetElement(const glm::ivec2 &index);
+    ElementRef GetElement(const glm::ivec2 &index);
     // Get an element from the chunk via direct array index
-    Element &GetElement(int index);
+    ElementRef GetElement(int index);
 
     void SetElement(int x, int y, const Element &element);
+    // works the collider bits out from the planes again, for when they were
+    // written without SetElement
+    void UpdateBitArray();
+
+    // the loaded chunk at m_ChunkPos + (dx, dy), where dx and dy are each
+    // -1, 0 or 1. nullptr if that neighbor isn't loaded.
+    Chunk *GetNeighbor(int dx, int dy) const {
+        return m_Neighbors[(dx + 1) + (dy + 1) * 3];
+    }
+    // the chunk that owns local position x, y, which can be up to one pixel
+    // outside of this chunk in any direction. nullptr if it isn't loaded.
+    Chunk *GetHaloChunk(int x, int y) const {
+        return GetNeighbor((x >= CHUNKSIZE) - (x < 0),
+                           (y >= CHUNKSIZE) - (y < 0));
+    }
+    // links this chunk and the loaded neighbor at the given offset, or unlinks
+    // them if neighbor is nullptr. both sides are kept in sync.
+    void SetNeighbor(int dx, int dy, Chunk *neighbor);
 
     void UpdateDirtyRect(int x, int y);
+    // same as UpdateDirtyRect, but safe to call from multiple threads at once.
+    // used when a chunk expands the dirty rect of its neighbor.
+    void UpdateDirtyRectLocked(int x, int y);
     void ResetDirtyRect();
+    // true when there is nothing left for the world to do with this chunk,
+    // no dirty rect to simulate and no mesh to rebuild.
+    bool IsSettled() const;
 
     void UpdateTexture();
     void UpdateWholeTexture();
@@ -39,14 +112,16 @@ class Chunk {
 
     // whether or not this chunk has a static collider
     bool m_MeshGenerated = false;
-    bool m_MeshChanged = true;
+    // neighbors in the same update phase can both mark a chunk at once, so
+    // this is atomic. see MarkMeshChanged.
+    std::atomic<bool> m_MeshChanged = true;
+    // safe to call while chunks are being updated in parallel
+    void MarkMeshChanged() {
+        m_MeshChanged.store(true, std::memory_order_relaxed);
+    }
     void GenerateMesh();
     void AddPreviousMesh();
 
-    void QueuePull(glm::ivec2 startPos,
-                   std::unordered_set<glm::ivec2, VectorHash> &result,
-                   std::unordered_set<glm::ivec2, VectorHash> &source);
-
     std::vector<b2Vec2>
     GetContourPoints(const std::unordered_set<glm::ivec2, VectorHash> &source);
     int GetMarchingSquareCase(
@@ -56,14 +131,25 @@ class Chunk {
                                        int startIndex, int endIndex,
                                        float threshold);
 
-    // core chunk elements
+    // core chunk elements are in ChunkPlanes, stored as separate planes so
+    // the update loop only pulls in the parts of an element it actually
+    // touches. GetElement ties them back together into an ElementRef.
     glm::ivec2 m_ChunkPos;
-    Element m_Elements[CHUNKSIZE * CHUNKSIZE];
 
     // buckets for dirty rects
     int m_DirtyRectBorderWidth = 2;
     DirtyRect m_DirtyRect;
     bool m_PersistDirtyRect = false;
+    std::mutex m_DirtyRectMutex;
+
+    // the 3x3 block of loaded chunks around this one, indexed by
+    // (dx + 1) + (dy + 1) * 3. the center is always the chunk itself. kept up
+    // to date by the world as chunks are added and removed, so border cells
+    // never need to look their neighbor up in the world.
+    Chunk *m_Neighbors[9] = {};
+
+    // whether the chunk is in the world's active set
+    std::atomic<bool> m_Awake = false;
 
     // textures and rendering
     Ref<Texture2D> m_Texture;
@@ -71,6 +157,13 @@ class Chunk {
 
     // Bitmap array for greedy meshing for collisions & shadows
     std::vector<uint64_t> m_BitArray;
+    // the bit array the collider was last made from, its quads, and the
+    // shape made from each quad, so a remesh only redoes the columns that
+    // changed, and only touches the shapes of quads that changed
+    std::vector<uint64_t> m_MeshedBitArray;
+    std::vector<BGMQuad> m_Quads;
+    std::vector<BGMQuad> m_PreviousQuads;
+    std::vector<b2ShapeId> m_QuadShapes;
 
     Ref<PhysicsBody2D> m_PhysicsBody;
 };
@@ -0,0 +1,123 @@
+#include "ChunkGenerator.h"
+#include "Chunk.h"
+
+namespace Pyxis {
+ChunkGenerator::ChunkGenerator(std::function<void(Chunk *)> generate)
+    : m_Generate(std::move(generate)) {
+    m_Thread = std::thread(&ChunkGenerator::GeneratorLoop, this);
+}
+
+ChunkGenerator::~ChunkGenerator() {
+    {
+        std::scoped_lock lock(m_Mutex);
+        m_Stopping = true;
+    }
+    m_WakeCondition.notify_all();
+    m_Thread.join();
+}
+
+void ChunkGenerator::Request(Chunk *chunk) {
+    {
+        std::scoped_lock lock(m_Mutex);
+        m_Queued.push_back(chunk);
+    }
+    m_WakeCondition.notify_one();
+}
+
+bool ChunkGenerator::Contains(const glm::ivec2 &chunkPos) {
+    std::scoped_lock lock(m_Mutex);
+    if (m_Ready.contains(chunkPos))
+        return true;
+    if (m_InFlight != nullptr && m_InFlight->m_ChunkPos == chunkPos)
+        return true;
+    for (Chunk *chunk : m_Queued) {
+        if (chunk->m_ChunkPos == chunkPos)
+            return true;
+    }
+    return false;
+}
+
+size_t ChunkGenerator::Size() {
+    std::scoped_lock lock(m_Mutex);
+    return m_Queued.size() + m_Ready.size() + (m_InFlight != nullptr);
+}
+
+Chunk *ChunkGenerator::Take(const glm::ivec2 &chunkPos, bool &generated) {
+    std::unique_lock lock(m_Mutex);
+    // the one being generated right now is the only one worth waiting for
+    m_DoneCondition.wait(lock, [this, &chunkPos] {
+        return m_InFlight == nullptr || m_InFlight->m_ChunkPos != chunkPos;
+    });
+
+    auto it = m_Ready.find(chunkPos);
+    if (it != m_Ready.end()) {
+        Chunk *chunk = it->second;
+        m_Ready.erase(it);
+        std::erase(m_ReadyOrder, chunk);
+        generated = true;
+        return chunk;
+    }
+
+    for (auto queued = m_Queued.begin(); queued != m_Queued.end(); queued++) {
+        if ((*queued)->m_ChunkPos == chunkPos) {
+            Chunk *chunk = *queued;
+            m_Queued.erase(queued);
+            generated = false;
+            return chunk;
+        }
+    }
+    return nullptr;
+}
+
+Chunk *ChunkGenerator::TakeOldestReady(
+    const std::unordered_set<glm::ivec2, VectorHash> &keep) {
+    std::scoped_lock lock(m_Mutex);
+    for (auto it = m_ReadyOrder.begin(); it != m_ReadyOrder.end(); it++) {
+        Chunk *chunk = *it;
+        if (keep.contains(chunk->m_ChunkPos))
+            continue;
+        m_ReadyOrder.erase(it);
+        m_Ready.erase(chunk->m_ChunkPos);
+        return chunk;
+    }
+    return nullptr;
+}
+
+void ChunkGenerator::TakeAll(std::vector<Chunk *> &chunks) {
+    std::unique_lock lock(m_Mutex);
+    chunks.insert(chunks.end(), m_Queued.begin(), m_Queued.end());
+    m_Queued.clear();
+    // whatever is in flight can't be stopped halfway, so let it finish
+    m_DoneCondition.wait(lock, [this] { return m_InFlight == nullptr; });
+    chunks.insert(chunks.end(), m_ReadyOrder.begin(), m_ReadyOrder.end());
+    m_ReadyOrder.clear();
+    m_Ready.clear();
+}
+
+void ChunkGenerator::GeneratorLoop() {
+    while (true) {
+        Chunk *chunk;
+        {
+            std::unique_lock lock(m_Mutex);
+            m_WakeCondition.wait(
+                lock, [this] { return m_Stopping || !m_Queued.empty(); });
+            if (m_Stopping)
+                return;
+            chunk = m_Queued.front();
+            m_Queued.pop_front();
+            m_InFlight = chunk;
+        }
+
+        m_Generate(chunk);
+
+        {
+            std::scoped_lock lock(m_Mutex);
+            m_InFlight = nullptr;
+            m_Ready[chunk->m_ChunkPos] = chunk;
+            m_ReadyOrder.push_back(chunk);
+        }
+        m_DoneCondition.notify_all();
+    }
+}
+
+} // namespace Pyxis
@@ -0,0 +1,71 @@
+#pragma once
+
+#include "VectorHash.h"
+#include <Pyxis.h>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+namespace Pyxis {
+class Chunk;
+
+/// <summary>
+/// Generates chunks ahead of time on a background thread.
+///
+/// The world requests positions it expects to need soon, handing over an empty
+/// chunk for each. A request is queued, then in flight while the generator
+/// thread fills it, then ready. None of these chunks are part of the world, so
+/// prefetching never changes the simulation. The world takes a chunk back out
+/// once it actually needs that position, and only has to wait if the chunk is
+/// being generated right then.
+/// </summary>
+class ChunkGenerator {
+  public:
+    ChunkGenerator(std::function<void(Chunk *)> generate);
+    ~ChunkGenerator();
+
+    ChunkGenerator(const ChunkGenerator &) = delete;
+    ChunkGenerator &operator=(const ChunkGenerator &) = delete;
+
+    // queues an empty chunk, already reset to its position, for generation
+    void Request(Chunk *chunk);
+    // whether the position is queued, in flight or ready
+    bool Contains(const glm::ivec2 &chunkPos);
+    // number of chunks the generator is holding in any state
+    size_t Size();
+
+    // takes the chunk for the position back out of the generator. generated
+    // is false if it was still queued, in which case the caller has to
+    // generate it. waits if it is in flight. nullptr if it was never requested.
+    Chunk *Take(const glm::ivec2 &chunkPos, bool &generated);
+    // takes back the ready chunk that has been waiting the longest, skipping
+    // any whose position is in keep. nullptr if there is no such chunk
+    Chunk *
+    TakeOldestReady(const std::unordered_set<glm::ivec2, VectorHash> &keep);
+    // takes back every chunk, in any state, without generating the rest
+    void TakeAll(std::vector<Chunk *> &chunks);
+
+  private:
+    void GeneratorLoop();
+
+    std::function<void(Chunk *)> m_Generate;
+    std::thread m_Thread;
+
+    std::mutex m_Mutex;
+    std::condition_variable m_WakeCondition;
+    std::condition_variable m_DoneCondition;
+
+    std::deque<Chunk *> m_Queued;
+    Chunk *m_InFlight = nullptr;
+    // ready chunks in the order they finished, and by position
+    std::deque<Chunk *> m_ReadyOrder;
+    std::unordered_map<glm::ivec2, Chunk *, VectorHash> m_Ready;
+    bool m_Stopping = false;
+};
+
+} // namespace Pyxis
@@ -0,0 +1,297 @@
+#include "ChunkStorage.h"
+#include "Chunk.h"
+#include <cstring>
+#include <fstream>
+
+namespace Pyxis {
+
+namespace {
+constexpr uint32_t s_ChunkMagic = 0x4B435850; // "PXCK"
+constexpr uint32_t s_DeltaMagic = 0x44435850; // "PXCD"
+constexpr uint16_t s_ChunkVersion = 1;
+constexpr int s_CellCount = CHUNKSIZE * CHUNKSIZE;
+
+template <typename T> void Write(std::vector<uint8_t> &out, const T &value) {
+    size_t offset = out.size();
+    out.resize(offset + sizeof(T));
+    std::memcpy(out.data() + offset, &value, sizeof(T));
+}
+
+template <typename T>
+bool Read(const std::vector<uint8_t> &in, size_t &offset, T &value) {
+    if (offset + sizeof(T) > in.size())
+        return false;
+    std::memcpy(&value, in.data() + offset, sizeof(T));
+    offset += sizeof(T);
+    return true;
+}
+
+// writes the values as (count, value) runs. values are compared bitwise so
+// floats round trip exactly.
+template <typename T>
+void WritePlane(std::vector<uint8_t> &out, const T *plane,
+                int size = s_CellCount) {
+    int start = 0;
+    while (start < size) {
+        int end = start + 1;
+        while (end < size &&
+               std::memcmp(&plane[end], &plane[start], sizeof(T)) == 0) {
+            end++;
+        }
+        Write(out, static_cast<uint16_t>(end - start));
+        Write(out, plane[start]);
+        start = end;
+    }
+}
+
+template <typename T>
+bool ReadPlane(const std::vector<uint8_t> &in, size_t &offset, T *plane,
+               int size = s_CellCount) {
+    int filled = 0;
+    while (filled < size) {
+        uint16_t count;
+        T value;
+        if (!Read(in, offset, count) || !Read(in, offset, value))
+            return false;
+        if (count == 0 || filled + count > size)
+            return false;
+        std::fill(plane + filled, plane + filled + count, value);
+        filled += count;
+    }
+    return true;
+}
+
+// copies the values of the given cells out of a plane
+template <typename T>
+void Gather(const T *plane, const std::vector<uint16_t> &cells, T *out) {
+    for (size_t i = 0; i < cells.size(); i++) {
+        out[i] = plane[cells[i]];
+    }
+}
+
+bool SameCell(const ChunkPlanes &a, const ChunkPlanes &b, int i) {
+    return a.m_IDs[i] == b.m_IDs[i] && a.m_BaseColors[i] == b.m_BaseColors[i] &&
+           a.m_Colors[i] == b.m_Colors[i] &&
+           std::memcmp(&a.m_Temperatures[i], &b.m_Temperatures[i],
+                       sizeof(float)) == 0 &&
+           a.m_Healths[i] == b.m_Healths[i] &&
+           a.m_Horizontals[i] == b.m_Horizontals[i] &&
+           a.m_Flags[i] == b.m_Flags[i];
+}
+} // namespace
+
+void ChunkCodec::Encode(const Chunk &chunk, std::vector<uint8_t> &out) {
+    out.clear();
+    Write(out, s_ChunkMagic);
+    Write(out, s_ChunkVersion);
+    Write(out, chunk.m_ChunkPos);
+
+    WritePlane(out, chunk.m_IDs);
+    WritePlane(out, chunk.m_BaseColors);
+    WritePlane(out, chunk.m_Colors);
+    WritePlane(out, chunk.m_Temperatures);
+    WritePlane(out, chunk.m_Healths);
+    WritePlane(out, chunk.m_Horizontals);
+    WritePlane(out, chunk.m_Flags);
+
+    for (uint64_t column : chunk.m_BitArray) {
+        Write(out, column);
+    }
+}
+
+bool ChunkCodec::Decode(const std::vector<uint8_t> &in, Chunk &chunk) {
+    size_t offset = 0;
+    uint32_t magic;
+    uint16_t version;
+    glm::ivec2 chunkPos;
+    if (!Read(in, offset, magic) || magic != s_ChunkMagic)
+        return false;
+    if (!Read(in, offset, version) || version != s_ChunkVersion)
+        return false;
+    if (!Read(in, offset, chunkPos) || chunkPos != chunk.m_ChunkPos)
+        return false;
+
+    if (!ReadPlane(in, offset, chunk.m_IDs) ||
+        !ReadPlane(in, offset, chunk.m_BaseColors) ||
+        !ReadPlane(in, offset, chunk.m_Colors) ||
+        !ReadPlane(in, offset, chunk.m_Temperatures) ||
+        !ReadPlane(in, offset, chunk.m_Healths) ||
+        !ReadPlane(in, offset, chunk.m_Horizontals) ||
+        !ReadPlane(in, offset, chunk.m_Flags))
+        return false;
+
+    for (uint64_t &column : chunk.m_BitArray) {
+        if (!Read(in, offset, column))
+            return false;
+    }
+    return offset == in.size();
+}
+
+int ChunkCodec::EncodeDelta(const Chunk &chunk, const ChunkPlanes &base,
+                            std::vector<uint8_t> &out) {
+    out.clear();
+    Write(out, s_DeltaMagic);
+    Write(out, s_ChunkVersion);
+    Write(out, chunk.m_ChunkPos);
+
+    // which cells changed, as alternating unchanged / changed run lengths
+    std::vector<uint16_t> cells;
+    bool changed = false;
+    int runStart = 0;
+    for (int i = 0; i <= s_CellCount; i++) {
+        bool cellChanged = i < s_CellCount && !SameCell(chunk, base, i);
+        if (i == s_CellCount || cellChanged != changed) {
+            Write(out, static_cast<uint16_t>(i - runStart));
+            runStart = i;
+            changed = cellChanged;
+        }
+        if (cellChanged)
+            cells.push_back(static_cast<uint16_t>(i));
+    }
+
+    // then just the changed values, plane by plane
+    int count = static_cast<int>(cells.size());
+    if (count > 0) {
+        auto writeChanged = [&](const auto *plane) {
+            using T = std::remove_cvref_t<decltype(*plane)>;
+            std::vector<T> gathered(count);
+            Gather(plane, cells, gathered.data());
+            WritePlane(out, gathered.data(), count);
+        };
+        writeChanged(chunk.m_IDs);
+        writeChanged(chunk.m_BaseColors);
+        writeChanged(chunk.m_Colors);
+        writeChanged(chunk.m_Temperatures);
+        writeChanged(chunk.m_Healths);
+        writeChanged(chunk.m_Horizontals);
+        writeChanged(chunk.m_Flags);
+    }
+    return count;
+}
+
+bool ChunkCodec::DecodeDelta(const std::vector<uint8_t> &in, Chunk &chunk) {
+    size_t offset = 0;
+    uint32_t magic;
+    uint16_t version;
+    glm::ivec2 chunkPos;
+    if (!Read(in, offset, magic) || magic != s_DeltaMagic)
+        return false;
+    if (!Read(in, offset, version) || version != s_ChunkVersion)
+        return false;
+    if (!Read(in, offset, chunkPos) || chunkPos != chunk.m_ChunkPos)
+        return false;
+
+    std::vector<uint16_t> cells;
+    bool changed = false;
+    int covered = 0;
+    while (covered < s_CellCount) {
+        uint16_t run;
+        if (!Read(in, offset, run) || covered + run > s_CellCount)
+            return false;
+        if (changed) {
+            for (int i = covered; i < covered + run; i++) {
+                cells.push_back(static_cast<uint16_t>(i));
+            }
+        }
+        covered += run;
+        changed = !changed;
+    }
+
+    int count = static_cast<int>(cells.size());
+    if (count > 0) {
+        std::vector<uint16_t> ids(count);
+        std::vector<uint32_t> baseColors(count), colors(count);
+        std::vector<float> temperatures(count);
+        std::vector<int32_t> healths(count);
+        std::vector<int8_t> horizontals(count);
+        std::vector<uint8_t> flags(count);
+        if (!ReadPlane(in, offset, ids.data(), count) ||
+            !ReadPlane(in, offset, baseColors.data(), count) ||
+            !ReadPlane(in, offset, colors.data(), count) ||
+            !ReadPlane(in, offset, temperatures.data(), count) ||
+            !ReadPlane(in, offset, healths.data(), count) ||
+            !ReadPlane(in, offset, horizontals.data(), count) ||
+            !ReadPlane(in, offset, flags.data(), count))
+            return false;
+
+        for (int i = 0; i < count; i++) {
+            ElementRef element(ids[i], baseColors[i], colors[i],
+                               temperatures[i], healths[i], horizontals[i],
+                               flags[i]);
+            chunk.SetElement(cells[i] % CHUNKSIZE, cells[i] / CHUNKSIZE,
+                             element);
+        }
+    }
+    return offset == in.size();
+}
+
+ChunkStorage::ChunkStorage() {
+    m_Directory = std::filesystem::temp_directory_path() / "PyxisChunks" /
+                  std::to_string(CreateUUID());
+}
+
+ChunkStorage::~ChunkStorage() { Clear(); }
+
+bool ChunkStorage::Store(const Chunk &chunk) {
+    std::error_code error;
+    std::filesystem::create_directories(m_Directory, error);
+    if (error) {
+        PX_ERROR("Couldn't create chunk storage directory {0}: {1}",
+                 m_Directory.string(), error.message());
+        return false;
+    }
+
+    ChunkCodec::Encode(chunk, m_Buffer);
+    std::ofstream file(GetChunkPath(chunk.m_ChunkPos),
+                       std::ios::binary | std::ios::trunc);
+    file.write(reinterpret_cast<const char *>(m_Buffer.data()),
+               m_Buffer.size());
+    if (!file) {
+        PX_ERROR("Couldn't write chunk ({0},{1}) to disk", chunk.m_ChunkPos.x,
+                 chunk.m_ChunkPos.y);
+        return false;
+    }
+    m_StoredChunks.insert(chunk.m_ChunkPos);
+    return true;
+}
+
+bool ChunkStorage::Load(const glm::ivec2 &chunkPos, Chunk &chunk) {
+    if (!m_StoredChunks.contains(chunkPos))
+        return false;
+
+    std::filesystem::path path = GetChunkPath(chunkPos);
+    std::ifstream file(path, std::ios::binary | std::ios::ate);
+    bool loaded = false;
+    if (file) {
+        m_Buffer.resize(static_cast<size_t>(file.tellg()));
+        file.seekg(0);
+        file.read(reinterpret_cast<char *>(m_Buffer.data()), m_Buffer.size());
+        loaded = file && ChunkCodec::Decode(m_Buffer, chunk);
+    }
+    file.close();
+
+    // only forget the chunk once it is safely back in memory
+    if (!loaded) {
+        PX_ERROR("Couldn't read chunk ({0},{1}) back from disk, keeping {2}",
+                 chunkPos.x, chunkPos.y, path.string());
+        return false;
+    }
+    m_StoredChunks.erase(chunkPos);
+    std::error_code error;
+    std::filesystem::remove(path, error);
+    return true;
+}
+
+void ChunkStorage::Clear() {
+    m_StoredChunks.clear();
+    std::error_code error;
+    std::filesystem::remove_all(m_Directory, error);
+}
+
+std::filesystem::path
+ChunkStorage::GetChunkPath(const glm::ivec2 &chunkPos) const {
+    return m_Directory / (std::to_string(chunkPos.x) + "_" +
+                          std::to_string(chunkPos.y) + ".chunk");
+}
+
+} // namespace Pyxis
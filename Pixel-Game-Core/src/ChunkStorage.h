@@ -0,0 +1,84 @@
+#pragma once
+
+#include "VectorHash.h"
+#include <Pyxis.h>
+#include <filesystem>
+#include <unordered_set>
+#include <vector>
+
+namespace Pyxis {
+class Chunk;
+struct ChunkPlanes;
+
+/// <summary>
+/// Compact binary encoding of a chunk's elements.
+///
+/// Every element plane is run length encoded on its own, since large parts of
+/// a chunk tend to share an id, temperature or health even when their colors
+/// differ. The collider bit array is stored as is, so a decoded chunk only
+/// needs its mesh rebuilt.
+///
+/// A delta only holds the cells that differ from a base chunk, which is the
+/// chunk as World::GenerateChunk made it. Anyone with the world seed can make
+/// the base themselves, so chunks nobody has touched cost a few bytes.
+/// </summary>
+namespace ChunkCodec {
+void Encode(const Chunk &chunk, std::vector<uint8_t> &out);
+// returns false if the data is truncated or not a chunk, leaving the chunk in
+// an unspecified state.
+bool Decode(const std::vector<uint8_t> &in, Chunk &chunk);
+
+// encodes the cells of chunk that differ from base, and returns how many
+// there were
+int EncodeDelta(const Chunk &chunk, const ChunkPlanes &base,
+                std::vector<uint8_t> &out);
+// applies a delta to a chunk that holds its generated base. cells are set
+// through Chunk::SetElement, so the collider bits stay correct.
+bool DecodeDelta(const std::vector<uint8_t> &in, Chunk &chunk);
+} // namespace ChunkCodec
+
+/// <summary>
+/// Keeps chunks that the world has evicted on disk, one file per chunk, until
+/// the world asks for them again.
+///
+/// Each storage writes into its own temporary directory, which is removed
+/// when the storage is cleared or destroyed, so two worlds in the same process
+/// never see each other's chunks.
+/// </summary>
+class ChunkStorage {
+  public:
+    ChunkStorage();
+    ~ChunkStorage();
+
+    ChunkStorage(const ChunkStorage &) = delete;
+    ChunkStorage &operator=(const ChunkStorage &) = delete;
+
+    bool Contains(const glm::ivec2 &chunkPos) const {
+        return m_StoredChunks.contains(chunkPos);
+    }
+    bool Empty() const { return m_StoredChunks.empty(); }
+    size_t Size() const { return m_StoredChunks.size(); }
+    const std::unordered_set<glm::ivec2, VectorHash> &GetStoredChunks() const {
+        return m_StoredChunks;
+    }
+
+    // writes the chunk out, returns false if the file couldn't be written
+    bool Store(const Chunk &chunk);
+    // reads a stored chunk back into chunk, and forgets it. returns false if
+    // it wasn't stored or couldn't be read. a chunk that couldn't be read is
+    // kept on disk, and may have left chunk partly overwritten.
+    bool Load(const glm::ivec2 &chunkPos, Chunk &chunk);
+
+    // forgets every stored chunk and deletes their files
+    void Clear();
+
+  private:
+    std::filesystem::path GetChunkPath(const glm::ivec2 &chunkPos) const;
+
+    std::filesystem::path m_Directory;
+    std::unordered_set<glm::ivec2, VectorHash> m_StoredChunks;
+    // reused between chunks so streaming doesn't allocate every time
+    std::vector<uint8_t> m_Buffer;
+};
+
+} // namespace Pyxis
@@ -0,0 +1,99 @@
+#include "ChunkWorker.h"
+
+namespace Pyxis {
+ChunkWorker::ChunkWorker(uint32_t threadCount) {
+    if (threadCount == 0) {
+        uint32_t hardwareThreads = std::thread::hardware_concurrency();
+        threadCount = hardwareThreads > 1 ? hardwareThreads - 1 : 0;
+    }
+
+    m_Threads.reserve(threadCount);
+    for (uint32_t i = 0; i < threadCount; i++) {
+        m_Threads.emplace_back(&ChunkWorker::WorkerLoop, this);
+    }
+}
+
+ChunkWorker::~ChunkWorker() {
+    {
+        std::scoped_lock lock(m_Mutex);
+        m_Stopping = true;
+    }
+    m_WakeCondition.notify_all();
+    for (auto &thread : m_Threads) {
+        thread.join();
+    }
+}
+
+void ChunkWorker::Dispatch(size_t count,
+                           const std::function<void(size_t)> &job) {
+    if (count == 0)
+        return;
+
+    // not worth waking anyone up for a single job
+    if (m_Threads.empty() || count == 1) {
+        for (size_t i = 0; i < count; i++) {
+            job(i);
+        }
+        return;
+    }
+
+    {
+        std::unique_lock lock(m_Mutex);
+        // a worker that woke up late for the last dispatch could still be
+        // looking at the old job counter, so wait for it to leave first.
+        m_DoneCondition.wait(lock, [this] { return m_BusyWorkers == 0; });
+        m_Job = &job;
+        m_JobCount = count;
+        m_NextJob = 0;
+        m_Generation++;
+    }
+    m_WakeCondition.notify_all();
+
+    RunJobs(&job, count);
+
+    std::unique_lock lock(m_Mutex);
+    m_DoneCondition.wait(lock, [this] { return m_BusyWorkers == 0; });
+    // every index has been claimed, and everyone who claimed one is done.
+    m_Job = nullptr;
+    m_JobCount = 0;
+}
+
+void ChunkWorker::WorkerLoop() {
+    uint64_t generation = 0;
+    while (true) {
+        const std::function<void(size_t)> *job;
+        size_t count;
+        {
+            std::unique_lock lock(m_Mutex);
+            m_WakeCondition.wait(lock, [this, generation] {
+                return m_Stopping || m_Generation != generation;
+            });
+            if (m_Stopping)
+                return;
+            generation = m_Generation;
+            job = m_Job;
+            count = m_JobCount;
+            m_BusyWorkers++;
+        }
+
+        RunJobs(job, count);
+
+        {
+            std::scoped_lock lock(m_Mutex);
+            m_BusyWorkers--;
+        }
+        m_DoneCondition.notify_all();
+    }
+}
+
+void ChunkWorker::RunJobs(const std::function<void(size_t)> *job,
+                          size_t count) {
+    while (true) {
+        size_t index = m_NextJob.fetch_add(1, std::memory_order_relaxed);
+        if (index >= count)
+            return;
+        (*job)(index);
+    }
+}
+
+} // namespace Pyxis
@@ -0,0 +1,57 @@
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace Pyxis {
+
+/// <summary>
+/// A small pool of persistent threads used by the world to run chunk jobs.
+///
+/// Dispatch hands out job indices from a shared counter, so each index runs
+/// exactly once. The calling thread works alongside the pool and Dispatch
+/// only returns once every job has finished, which lets the world run its
+/// update phases back to back without any other synchronization.
+/// </summary>
+class ChunkWorker {
+  public:
+    // threadCount of 0 uses one worker per hardware thread, minus the caller.
+    ChunkWorker(uint32_t threadCount = 0);
+    ~ChunkWorker();
+
+    ChunkWorker(const ChunkWorker &) = delete;
+    ChunkWorker &operator=(const ChunkWorker &) = delete;
+
+    // runs job(0) ... job(count - 1) across the pool, and blocks until all of
+    // them are finished.
+    void Dispatch(size_t count, const std::function<void(size_t)> &job);
+
+    uint32_t GetThreadCount() const {
+        return static_cast<uint32_t>(m_Threads.size());
+    }
+
+  private:
+    void WorkerLoop();
+    void RunJobs(const std::function<void(size_t)> *job, size_t count);
+
+    std::vector<std::thread> m_Threads;
+
+    std::mutex m_Mutex;
+    std::condition_variable m_WakeCondition;
+    std::condition_variable m_DoneCondition;
+
+    // current dispatch, only changed under m_Mutex while no worker is busy
+    const std::function<void(size_t)> *m_Job = nullptr;
+    size_t m_JobCount = 0;
+    uint64_t m_Generation = 0;
+    uint32_t m_BusyWorkers = 0;
+    bool m_Stopping = false;
+
+    std::atomic<size_t> m_NextJob = 0;
+};
+
+} // namespace Pyxis
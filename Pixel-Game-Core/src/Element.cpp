@@ -21,7 +21,8 @@ void ElementData::LoadElementData(const std::string &path) {
     s_ElementNameToID.clear();
     s_TagElements.clear();
     s_Reactions.clear();
-    s_ReactionTable.clear();
+    s_ReactionMatrix.clear();
+    s_SimElementInfo.clear();
 
     // load the json file
     std::ifstream file(path);
@@ -43,9 +44,70 @@ void ElementData::LoadElementData(const std::string &path) {
             s_Reactions.push_back(reaction);
         }
     }
+    // chunks store ids in 16 bits
+    PX_ASSERT(s_ElementData.size() <= std::numeric_limits<uint16_t>::max(),
+              "Too many elements to fit in a chunk's id plane!");
+    BuildSimElementInfo();
     BuildReactionTable();
 }
 
+void ElementData::BuildSimElementInfo() {
+    // resolves a name to an id. names that don't exist fall back to air, which
+    // is what looking them up in s_ElementNameToID used to give us.
+    auto resolve = [](const std::string &name, uint32_t none) {
+        if (name == "")
+            return none;
+        auto it = s_ElementNameToID.find(name);
+        if (it == s_ElementNameToID.end()) {
+            PX_ERROR("Element \"{0}\" does not exist", name);
+            return 0u;
+        }
+        return it->second;
+    };
+
+    s_SimElementInfo.clear();
+    s_SimElementInfo.reserve(s_ElementData.size());
+    s_ColliderSolid.assign(s_ElementData.size(), false);
+    for (const ElementProperties &properties : s_ElementData) {
+        SimElementInfo info;
+        info.cell_type = properties.cell_type;
+        info.flammable = properties.flammable;
+        info.spread_ignition = properties.spread_ignition;
+        info.glow = properties.glow;
+        info.density = properties.density;
+        info.friction = properties.friction;
+        info.conductivity = properties.conductivity;
+        info.spread_ignition_chance = properties.spread_ignition_chance;
+        info.ignited_color = properties.ignited_color;
+        info.fire_color = properties.fire_color;
+        info.health = properties.health;
+        info.ignition_temperature = properties.ignition_temperature;
+        info.fire_temperature = properties.fire_temperature;
+        info.fire_temperature_increase = properties.fire_temperature_increase;
+        info.melting_point = properties.melting_point;
+        info.freezing_point = properties.freezing_point;
+        info.melted_id = resolve(properties.melted, SimElementInfo::NoElement);
+        info.frozen_id = resolve(properties.frozen, SimElementInfo::NoElement);
+        info.burnt_id = resolve(properties.burnt, 0);
+        s_SimElementInfo.push_back(info);
+
+        s_ColliderSolid[s_SimElementInfo.size() - 1] =
+            properties.cell_type == ElementType::solid ||
+            properties.cell_type == ElementType::movableSolid;
+    }
+
+    auto findID = [](const std::string &name, uint32_t missing) {
+        auto it = s_ElementNameToID.find(name);
+        return it != s_ElementNameToID.end() ? it->second : missing;
+    };
+    s_FireID = findID("fire", 0);
+    s_DebugHeatID = findID("debug_heat", SimElementInfo::NoElement);
+    s_DebugCoolID = findID("debug_cool", SimElementInfo::NoElement);
+    s_GrassID = findID("grass", SimElementInfo::NoElement);
+    s_DirtID = findID("dirt", SimElementInfo::NoElement);
+    s_StoneID = findID("stone", SimElementInfo::NoElement);
+}
+
 Element ElementData::GetElement(uint32_t id, int x, int y) {
     Element element = Element();
     if (id < s_ElementData.size()) {
@@ -67,6 +129,10 @@ Element ElementData::GetElement(const std::string &name, int x, int y) {
 }
 
 void ElementData::BuildReactionTable() {
+    // every pair starts out with no reaction
+    size_t count = s_ElementData.size();
+    s_ReactionMatrix.assign(count * count, ReactionResult(0, 0, 0));
+
     std::string input0Tag, input1Tag;
     // loop over each reaction
     for (Reaction reaction : s_Reactions) {
@@ -97,14 +163,14 @@ void ElementData::BuildReactionTable() {
                             idOut1 = s_ElementNameToID[reaction.output_cell_1];
                         }
                         // all id's obtained
-                        s_ReactionTable[id0][id1] = ReactionResult(
+                        s_ReactionMatrix[id0 * count + id1] = ReactionResult(
                             reaction.probablility, idOut0, idOut1);
                     }
                 } else {
                     uint32_t id1 = s_ElementNameToID[reaction.input_cell_1];
                     uint32_t idOut1 = s_ElementNameToID[reaction.output_cell_1];
                     // all id's obtained
-                    s_ReactionTable[id0][id1] =
+                    s_ReactionMatrix[id0 * count + id1] =
                         ReactionResult(reaction.probablility, idOut0, idOut1);
                     /*m_ReactionLookup[id1][id0] =
                      * ReactionResult(reaction.probablility, idOut1, idOut0);*/
@@ -127,14 +193,14 @@ void ElementData::BuildReactionTable() {
                         idOut1 = s_ElementNameToID[reaction.output_cell_1];
                     }
                     // all id's obtained
-                    s_ReactionTable[id0][id1] =
+                    s_ReactionMatrix[id0 * count + id1] =
                         ReactionResult(reaction.probablility, idOut0, idOut1);
                 }
             } else {
                 uint32_t id1 = s_ElementNameToID[reaction.input_cell_1];
                 uint32_t idOut1 = s_ElementNameToID[reaction.output_cell_1];
                 // all id's obtained
-                s_ReactionTable[id0][id1] =
+                s_ReactionMatrix[id0 * count + id1] =
                     ReactionResult(reaction.probablility, idOut0, idOut1);
             }
         }
@@ -179,67 +245,47 @@ Element ElementProperties::GetElement(int x, int y) const {
     return element;
 }
 
-void ElementProperties::UpdateElementProperties(Element &element, int x,
-                                                int y) const {
-    if (texture_data != nullptr) {
-        glm::ivec2 result;
-        if (x < 0) {
-            result.x = width - (std::abs(x) % width);
-            result.x = result.x % width;
-        } else
-            result.x = x % width;
-        if (y < 0) {
-            result.y = height - (std::abs(y) % height);
-            result.y = result.y % height;
-        } else
-            result.y = y % height;
-        int index = (result.x * 4) + (result.y * width * 4);
+uint32_t ElementProperties::GetBaseColor(int x, int y) const {
+    if (texture_data == nullptr)
+        return color; // RandomizeABGRColor(color);
 
-        uint8_t r = texture_data[index];
-        uint8_t g = texture_data[index + 1];
-        uint8_t b = texture_data[index + 2];
-        uint8_t a = texture_data[index + 3];
+    glm::ivec2 result;
+    if (x < 0) {
+        result.x = width - (std::abs(x) % width);
+        result.x = result.x % width;
+    } else
+        result.x = x % width;
+    if (y < 0) {
+        result.y = height - (std::abs(y) % height);
+        result.y = result.y % height;
+    } else
+        result.y = y % height;
+    int index = (result.x * 4) + (result.y * width * 4);
 
-        element.m_BaseColor = (a << 24) | (b << 16) | (g << 8) | r;
-    } else {
-        element.m_BaseColor = color; // RandomizeABGRColor(color);
-    }
+    uint8_t r = texture_data[index];
+    uint8_t g = texture_data[index + 1];
+    uint8_t b = texture_data[index + 2];
+    uint8_t a = texture_data[index + 3];
+
+    return (a << 24) | (b << 16) | (g << 8) | r;
+}
+
+void ElementProperties::UpdateElementProperties(Element &element, int x,
+                                                int y) const {
+    element.m_BaseColor = GetBaseColor(x, y);
     element.m_Color = element.m_BaseColor;
     element.m_Temperature = temperature;
     element.m_Ignited = ignited;
     element.m_Health = health;
 }
 
-void ElementProperties::UpdateElementProperties(Element *element, int x,
+void ElementProperties::UpdateElementProperties(ElementRef element, int x,
                                                 int y) const {
-    if (texture_data != nullptr) {
-        glm::ivec2 result;
-        if (x < 0) {
-            result.x = width - (std::abs(x) % width);
-            result.x = result.x % width;
-        } else
-            result.x = x % width;
-        if (y < 0) {
-            result.y = height - (std::abs(y) % height);
-            result.y = result.y % height;
-        } else
-            result.y = y % height;
-
-        int index = (result.x * 4) + (y * width * 4);
-
-        uint8_t r = texture_data[index];
-        uint8_t g = texture_data[index + 1];
-        uint8_t b = texture_data[index + 2];
-        uint8_t a = texture_data[index + 3];
-
-        element->m_BaseColor = (a << 24) | (b << 16) | (g << 8) | r;
-    } else {
-        element->m_BaseColor = color; // RandomizeABGRColor(color);
-    }
-    element->m_Color = element->m_BaseColor;
-    element->m_Temperature = temperature;
-    element->m_Ignited = ignited;
-    element->m_Health = health;
+    element.m_BaseColor = GetBaseColor(x, y);
+    element.m_Color = element.m_BaseColor;
+    element.m_Temperature = temperature;
+    element.m_Ignited = ignited;
+    element.m_Health = health;
 }
 
 void to_json(json &j, const ElementProperties &e) {
@@ -121,6 +121,97 @@ struct Element {
     }
 };
 
+// the bools of an element, packed into one byte in chunk storage
+enum ElementFlag : uint8_t {
+    ElementFlag_Ignited = 1 << 0,
+    ElementFlag_Sliding = 1 << 1,
+    ElementFlag_Rigid = 1 << 2,
+    ElementFlag_Updated = 1 << 3,
+};
+
+/// <summary>
+/// A reference to an element living in a chunk's planes. Reads and writes go
+/// straight to the chunk, so it can be used like an Element&, and it converts
+/// to and from a plain Element for copies.
+///
+/// Assigning one ElementRef to another copies the element, it does not
+/// re-point the reference.
+/// </summary>
+struct ElementRef {
+  public:
+    // a single bit of the packed flags, acting like a bool&
+    struct FlagRef {
+        FlagRef(uint8_t &flags, uint8_t mask) : m_Flags(flags), m_Mask(mask) {}
+        operator bool() const { return (m_Flags & m_Mask) != 0; }
+        FlagRef &operator=(bool value) {
+            m_Flags = value ? static_cast<uint8_t>(m_Flags | m_Mask)
+                            : static_cast<uint8_t>(m_Flags & ~m_Mask);
+            return *this;
+        }
+        FlagRef &operator=(const FlagRef &other) {
+            return *this = static_cast<bool>(other);
+        }
+
+      private:
+        uint8_t &m_Flags;
+        uint8_t m_Mask;
+    };
+
+    ElementRef(uint16_t &id, uint32_t &baseColor, uint32_t &color,
+               float &temperature, int32_t &health, int8_t &horizontal,
+               uint8_t &flags)
+        : m_ID(id), m_BaseColor(baseColor), m_Color(color),
+          m_Ignited(flags, ElementFlag_Ignited), m_Health(health),
+          m_Temperature(temperature), m_Horizontal(horizontal),
+          m_Sliding(flags, ElementFlag_Sliding),
+          m_Rigid(flags, ElementFlag_Rigid),
+          m_Updated(flags, ElementFlag_Updated) {}
+
+    uint16_t &m_ID;
+    uint32_t &m_BaseColor;
+    uint32_t &m_Color;
+    FlagRef m_Ignited;
+    int32_t &m_Health;
+    float &m_Temperature;
+    int8_t &m_Horizontal;
+    FlagRef m_Sliding;
+    FlagRef m_Rigid;
+    FlagRef m_Updated;
+
+    operator Element() const {
+        Element element;
+        element.m_ID = m_ID;
+        element.m_BaseColor = m_BaseColor;
+        element.m_Color = m_Color;
+        element.m_Ignited = m_Ignited;
+        element.m_Health = m_Health;
+        element.m_Temperature = m_Temperature;
+        element.m_Horizontal = m_Horizontal;
+        element.m_Sliding = m_Sliding;
+        element.m_Rigid = m_Rigid;
+        element.m_Updated = m_Updated;
+        return element;
+    }
+
+    ElementRef &operator=(const Element &element) {
+        m_ID = static_cast<uint16_t>(element.m_ID);
+        m_BaseColor = element.m_BaseColor;
+        m_Color = element.m_Color;
+        m_Ignited = element.m_Ignited;
+        m_Health = element.m_Health;
+        m_Temperature = element.m_Temperature;
+        m_Horizontal = element.m_Horizontal;
+        m_Sliding = element.m_Sliding;
+        m_Rigid = element.m_Rigid;
+        m_Updated = element.m_Updated;
+        return *this;
+    }
+
+    ElementRef &operator=(const ElementRef &other) {
+        return *this = static_cast<Element>(other);
+    }
+};
+
 /// <summary>
 /// for tags, write the name of the tag in []'s like [meltable], and code will
 /// handle the rest
@@ -171,6 +262,7 @@ struct Reaction {
     }
 };
 
+// an empty slot in the reaction matrix has a probability of 0
 struct ReactionResult {
     ReactionResult() = default;
     ReactionResult(uint32_t percentChance, uint32_t cell0, uint32_t cell1) {
@@ -239,7 +331,10 @@ class ElementProperties {
     // Turns a given element into the element described by this data
     // does not update the element's ID.
     void UpdateElementProperties(Element &element, int x, int y) const;
-    void UpdateElementProperties(Element *element, int x, int y) const;
+    void UpdateElementProperties(ElementRef element, int x, int y) const;
+    // the base color of this element at a position, sampled from the texture
+    // if it has one
+    uint32_t GetBaseColor(int x, int y) const;
 
     // To json format for serialization
     friend void to_json(json &j, const ElementProperties &e);
@@ -247,6 +342,43 @@ class ElementProperties {
     friend void from_json(const json &j, ElementProperties &e);
 };
 
+/// <summary>
+/// The parts of ElementProperties the simulation reads for every cell, packed
+/// into a single cache line. Built by ElementData::LoadElementData, with the
+/// melted / frozen / burnt names already resolved to ids, so the update loop
+/// never has to touch a string.
+/// </summary>
+struct alignas(64) SimElementInfo {
+    inline static const uint32_t NoElement =
+        std::numeric_limits<uint32_t>::max();
+
+    ElementType cell_type = ElementType::gas;
+    bool flammable = false;
+    bool spread_ignition = false;
+    bool glow = false;
+
+    uint32_t density = 5;
+    uint32_t friction = 60;
+    uint32_t conductivity = 0;
+    uint32_t spread_ignition_chance = 10;
+    uint32_t ignited_color = 0;
+    uint32_t fire_color = 0;
+    int health = 100;
+
+    float ignition_temperature = 371.0f;
+    float fire_temperature = 1000;
+    float fire_temperature_increase = 10;
+    int melting_point = 100;
+    int freezing_point = 0;
+
+    // ids of the elements to turn into, NoElement if there is none
+    uint32_t melted_id = NoElement;
+    uint32_t frozen_id = NoElement;
+    uint32_t burnt_id = 0;
+};
+static_assert(sizeof(SimElementInfo) == 64,
+              "SimElementInfo should fit in one cache line");
+
 /// <summary>
 /// all the properties of an element
 /// </summary>
@@ -255,9 +387,15 @@ class ElementData {
     inline static std::vector<ElementProperties> s_ElementData;
 
     inline static std::vector<Reaction> s_Reactions;
-    inline static std::unordered_map<
-        uint32_t, std::unordered_map<uint32_t, ReactionResult>>
-        s_ReactionTable;
+    // dense N x N matrix of reactions, indexed [id0 * N + id1], where N is the
+    // number of elements.
+    inline static std::vector<ReactionResult> s_ReactionMatrix;
+    static const ReactionResult &GetReaction(uint32_t id0, uint32_t id1) {
+        size_t count = s_ElementData.size();
+        if (id0 >= count || id1 >= count)
+            return s_ReactionMatrix[0];
+        return s_ReactionMatrix[id0 * count + id1];
+    }
     inline static std::unordered_map<std::string, std::vector<uint32_t>>
         s_TagElements;
 
@@ -265,6 +403,30 @@ class ElementData {
     inline static std::map<std::string, uint32_t> s_ElementNameToID;
     static ElementProperties &GetElementProperties(const std::string &name);
 
+    // dense table for the simulation, indexed by element id
+    inline static std::vector<SimElementInfo> s_SimElementInfo;
+    static const SimElementInfo &GetSimInfo(uint32_t id) {
+        if (id >= s_SimElementInfo.size())
+            return s_SimElementInfo[0];
+        return s_SimElementInfo[id];
+    }
+
+    // one bit per element id, set if it is solid or movable solid, so it
+    // belongs in a chunk's collider when it isn't part of a rigid body
+    inline static std::vector<bool> s_ColliderSolid;
+    static bool IsColliderSolid(uint32_t id) {
+        return id < s_ColliderSolid.size() && s_ColliderSolid[id];
+    }
+
+    // ids the simulation refers to by name, resolved on load
+    inline static uint32_t s_FireID = 0;
+    inline static uint32_t s_DebugHeatID = SimElementInfo::NoElement;
+    inline static uint32_t s_DebugCoolID = SimElementInfo::NoElement;
+    // terrain generation
+    inline static uint32_t s_GrassID = SimElementInfo::NoElement;
+    inline static uint32_t s_DirtID = SimElementInfo::NoElement;
+    inline static uint32_t s_StoneID = SimElementInfo::NoElement;
+
     static void
     LoadElementData(const std::string &path = "assets/data/CellData.json");
 
@@ -273,6 +435,8 @@ class ElementData {
 
     // Building the reaction table so an element
     static void BuildReactionTable();
+    // compiles s_SimElementInfo out of s_ElementData
+    static void BuildSimElementInfo();
     static bool StringContainsTag(const std::string &string);
     static std::string TagFromString(const std::string &stringWithTag);
     static std::string ReplaceTagInString(const std::string &stringToFill,
@@ -45,11 +45,13 @@ void PixelBody2D::SetPixelBodyElements(
     SetPosition(glm::vec2(CenterPixelPosWorld) + glm::vec2(0.5f, 0.5f));
 
     // use the minimum to get local positions [example, from -10,-10 to 10,10]
+    ResetElements(glm::ivec2(minX, minY) - CenterPixelPosWorld, m_Width,
+                  m_Height);
+    m_HasRasterTransform = false;
     for (auto &pbe : elements) {
         glm::ivec2 localPos = pbe.worldPos - CenterPixelPosWorld;
-        m_Elements[localPos] = pbe;
+        SetBodyElement(localPos, pbe);
     }
-    m_LocalMinimum = glm::ivec2(minX, minY) - CenterPixelPosWorld;
     m_InWorld = true;
     GenerateMesh();
 }
@@ -61,10 +63,11 @@ void PixelBody2D::Serialize(json &j) {
     j["m_InWorld"] = m_InWorld;
     j["m_Width"] = m_Width;
     j["m_Height"] = m_Height;
+    j["m_LocalMinimum"] = m_LocalMinimum;
 
-    for (auto &[key, value] : m_Elements) {
-        j["m_Elements"] += {{"Key", key}, {"Value", value}};
-    }
+    ForEachBodyElement([&](glm::ivec2 localPos, PixelBodyElement &pbe) {
+        j["m_Elements"] += {{"Key", localPos}, {"Value", pbe}};
+    });
 }
 
 void PixelBody2D::Deserialize(json &j) {
@@ -77,80 +80,246 @@ void PixelBody2D::Deserialize(json &j) {
         j.at("m_Width").get_to(m_Width);
     if (j.contains("m_Height"))
         j.at("m_Height").get_to(m_Height);
+    std::vector<std::pair<glm::ivec2, PixelBodyElement>> elements;
+    glm::ivec2 minimum = {INT_MAX, INT_MAX};
+    glm::ivec2 maximum = {INT_MIN, INT_MIN};
     if (j.contains("m_Elements")) {
+        elements.reserve(j.at("m_Elements").size());
         for (auto &element : j.at("m_Elements")) {
             glm::ivec2 key;
             PixelBodyElement value;
             element.at("Key").get_to(key);
             element.at("Value").get_to(value);
-            m_Elements[key] = value;
+            minimum = glm::min(minimum, key);
+            maximum = glm::max(maximum, key);
+            elements.push_back({key, value});
         }
     }
+
+    // older saves don't have the minimum, so fall back to the smallest key,
+    // and make sure the grid covers every key either way
+    if (j.contains("m_LocalMinimum"))
+        j.at("m_LocalMinimum").get_to(m_LocalMinimum);
+    else if (!elements.empty())
+        m_LocalMinimum = minimum;
+    if (!elements.empty()) {
+        m_LocalMinimum = glm::min(m_LocalMinimum, minimum);
+        m_Width = std::max(m_Width, maximum.x - m_LocalMinimum.x + 1);
+        m_Height = std::max(m_Height, maximum.y - m_LocalMinimum.y + 1);
+    }
+
+    ResetElements(m_LocalMinimum, m_Width, m_Height);
+    for (auto &[key, value] : elements) {
+        SetBodyElement(key, value);
+    }
     // the body is made, and we have the elements. The elements should already
-    // be in the world too. I don't think theres anything else to do here.
+    // be in the world too. The shapes came back with the body, but we don't
+    // know which quad each one was made from, so the first remesh has to
+    // start over.
+    m_NeedsFullMesh = true;
 }
 
 void PixelBody2D::QueueFree() { m_FreeMe = true; }
 
+void PixelBody2D::ResetElements(glm::ivec2 localMinimum, int width,
+                                int height) {
+    m_LocalMinimum = localMinimum;
+    m_Width = width;
+    m_Height = height;
+    m_WordsPerColumn = ((height - 1) / 64) + 1;
+    m_Elements.assign(size_t(width) * height, PixelBodyElement());
+    m_Occupancy.assign(size_t(width) * m_WordsPerColumn, 0);
+    m_ElementCount = 0;
+
+    m_BandQuads.resize(m_WordsPerColumn);
+    m_BandDirtyColumns.assign(m_WordsPerColumn, 0);
+}
+
+void PixelBody2D::SetBodyElement(glm::ivec2 localPos,
+                                 const PixelBodyElement &pbe) {
+    glm::ivec2 cell = localPos - m_LocalMinimum;
+    uint64_t &word = m_Occupancy[cell.x * m_WordsPerColumn + (cell.y / 64)];
+    uint64_t bit = (uint64_t)1 << (cell.y % 64);
+    if (!(word & bit)) {
+        m_ElementCount++;
+        MarkColumnDirty(cell);
+    }
+    word |= bit;
+    m_Elements[cell.x * m_Height + cell.y] = pbe;
+}
+
+void PixelBody2D::RemoveBodyElement(glm::ivec2 localPos) {
+    if (!HasBodyElement(localPos))
+        return;
+    glm::ivec2 cell = localPos - m_LocalMinimum;
+    m_Occupancy[cell.x * m_WordsPerColumn + (cell.y / 64)] &=
+        ~((uint64_t)1 << (cell.y % 64));
+    m_ElementCount--;
+    MarkColumnDirty(cell);
+}
+
+std::vector<glm::ivec2> PixelBody2D::RemoveDisconnectedElements() {
+    std::vector<glm::ivec2> removed;
+    if (m_ElementCount == 0)
+        return removed;
+
+    // union-find over the grid. -1 is an empty cell, and every set is named
+    // after its lowest cell, so the result doesn't depend on anything but
+    // the grid itself.
+    std::vector<int> parent(m_Elements.size(), -1);
+    auto find = [&](int cell) {
+        while (parent[cell] != cell) {
+            parent[cell] = parent[parent[cell]];
+            cell = parent[cell];
+        }
+        return cell;
+    };
+    auto unite = [&](int a, int b) {
+        a = find(a);
+        b = find(b);
+        if (a != b)
+            parent[std::max(a, b)] = std::min(a, b);
+    };
+
+    // elements are visited column by column, bottom to top, so the cells
+    // below and to the left are already in the forest
+    ForEachBodyElement([&](glm::ivec2 localPos, PixelBodyElement &pbe) {
+        glm::ivec2 cell = localPos - m_LocalMinimum;
+        int index = cell.x * m_Height + cell.y;
+        parent[index] = index;
+        if (cell.y > 0 && parent[index - 1] != -1)
+            unite(index, index - 1);
+        if (cell.x > 0 && parent[index - m_Height] != -1)
+            unite(index, index - m_Height);
+    });
+
+    // the biggest part stays, ties going to the one found first
+    std::vector<int> sizes(m_Elements.size(), 0);
+    int biggest = -1;
+    ForEachBodyElement([&](glm::ivec2 localPos, PixelBodyElement &pbe) {
+        glm::ivec2 cell = localPos - m_LocalMinimum;
+        int root = find(cell.x * m_Height + cell.y);
+        sizes[root]++;
+        if (biggest == -1 || sizes[root] > sizes[biggest])
+            biggest = root;
+    });
+
+    ForEachBodyElement([&](glm::ivec2 localPos, PixelBodyElement &pbe) {
+        glm::ivec2 cell = localPos - m_LocalMinimum;
+        if (find(cell.x * m_Height + cell.y) != biggest) {
+            removed.push_back(pbe.worldPos);
+            RemoveBodyElement(localPos);
+        }
+    });
+    return removed;
+}
+
 void PixelBody2D::GenerateMesh() {
-    // clear prior mesh data
+    // clear prior mesh data, and mesh every band from the start
     RemoveShapes();
-    UpdateBitArrays();
+    m_Quads.clear();
+    m_Shapes.clear();
+    for (auto &quads : m_BandQuads) {
+        quads.clear();
+    }
+    std::fill(m_BandDirtyColumns.begin(), m_BandDirtyColumns.end(), 0);
+    m_NeedsFullMesh = false;
+    UpdateMesh();
+}
 
-    for (auto &kvp : m_BitArrays) {
-        std::vector<BGMQuad> quads = BinaryGreedyMesh(kvp.second);
-        for (auto &quad : quads) {
-            glm::vec2 quadPosition =
-                (quad.center + (glm::vec2(kvp.first * 64))) +
-                glm::vec2(m_LocalMinimum) - glm::vec2(0.5, 0.5);
-            AddBoxShape(quad.halfWidth / PPU, quad.halfHeight / PPU,
-                        quadPosition / PPU, 0);
+void PixelBody2D::UpdateMesh() {
+    // if the shapes we made are gone, like after the physics world was
+    // remade, or were never ours to begin with, start over
+    if (m_NeedsFullMesh) {
+        GenerateMesh();
+        return;
+    }
+    for (b2ShapeId shape : m_Shapes) {
+        if (!b2Shape_IsValid(shape)) {
+            GenerateMesh();
+            return;
         }
     }
 
-    // m_BitArrays is now populated. We still need to run BGM on it, and set the
-    // physics body shapes.
-}
-
-void PixelBody2D::UpdateBitArrays() {
-    m_BitArrays =
-        std::unordered_map<glm::ivec2, std::vector<uint64_t>, VectorHash>();
-    // we know the width and height, so we know how many 64x64 areas we would
-    // need.
-    int bitArrayXCount =
-        ((m_Width - 1) / 64) + 1; // 0-63 would produce 0, then add 1.
-    int bitArrayYCount = ((m_Height - 1) / 64) + 1;
-    for (int baY = 0; baY < bitArrayYCount; baY++) {
-        for (int baX = 0; baX < bitArrayXCount; baX++) {
-            glm::ivec2 bitArrayCoord = {baX, baY};
-            // looping over all needed bit arrays.
-            // we already know the minimum local position, so we offset by
-            // there.
-            std::vector<uint64_t> bitArray = std::vector<uint64_t>();
-            bitArray.reserve(64);
-            for (int x = 0; x < 64; x++) {
-                // looping over the x axis, and we will set every bit of array
-                uint64_t column = 0;
-                for (int y = 0; y < 64; y++) {
-                    glm::ivec2 bitArrayPixelCoord = {x, y};
-                    if (m_Elements.contains(bitArrayPixelCoord +
-                                            m_LocalMinimum)) {
-                        column |= ((uint64_t)1 << y); // set bit at y digit
-                    }
-                }
-                bitArray.push_back(column);
+    bool remeshed = false;
+    for (int band = 0; band < m_WordsPerColumn; band++) {
+        if (m_BandDirtyColumns[band] >= m_Width)
+            continue;
+        // the band is one word out of every column
+        m_BandColumns.resize(m_Width);
+        for (int x = 0; x < m_Width; x++) {
+            m_BandColumns[x] = m_Occupancy[x * m_WordsPerColumn + band];
+        }
+        BinaryGreedyMesh(m_BandColumns, m_BandQuads[band],
+                         m_BandDirtyColumns[band]);
+        m_BandDirtyColumns[band] = m_Width;
+        remeshed = true;
+    }
+    if (!remeshed)
+        return;
+
+    // join the bands. a quad that reaches the top of its band carries on
+    // into the quad over the same columns at the bottom of the next band,
+    // if there is one.
+    m_PreviousQuads.swap(m_Quads);
+    m_Quads.clear();
+    std::unordered_map<uint64_t, size_t> open;
+    std::unordered_map<uint64_t, size_t> nextOpen;
+    for (int band = 0; band < m_WordsPerColumn; band++) {
+        nextOpen.clear();
+        for (const BGMQuad &quad : m_BandQuads[band]) {
+            uint64_t columns =
+                ((uint64_t)quad.Left() << 32) | (uint32_t)quad.Width();
+            auto below = quad.Bottom() == 0 ? open.find(columns) : open.end();
+            size_t index;
+            if (below != open.end()) {
+                index = below->second;
+                BGMQuad &joined = m_Quads[index];
+                joined = Utils::MakeBGMQuad(quad.Left(), joined.Bottom(),
+                                            quad.Width(),
+                                            joined.Height() + quad.Height());
+            } else {
+                index = m_Quads.size();
+                m_Quads.push_back(Utils::MakeBGMQuad(
+                    quad.Left(), quad.Bottom() + band * 64, quad.Width(),
+                    quad.Height()));
             }
-            m_BitArrays[bitArrayCoord] = bitArray;
+            if (quad.Bottom() + quad.Height() == 64)
+                nextOpen[columns] = index;
         }
+        open.swap(nextOpen);
     }
+
+    // only the shapes of quads that changed are touched
+    bool changed = UpdateBGMShapes(
+        m_PreviousQuads, m_Quads, m_Shapes,
+        [&](b2ShapeId shape) { RemoveShape(shape); },
+        [&](const BGMQuad &quad) {
+            glm::vec2 quadPosition =
+                quad.center + glm::vec2(m_LocalMinimum) - glm::vec2(0.5, 0.5);
+            return AddBoxShape(quad.halfWidth / PPU, quad.halfHeight / PPU,
+                               quadPosition / PPU, 0);
+        });
+    // the mass is worked out once at the end
+    if (changed)
+        UpdateMass();
 }
 
 void PixelBody2D::UpdateElementWorldPositions() {
     m_Moved = false;
     // center of the pixel body in the world
     glm::ivec2 centerPixelWorld = glm::floor(GetPosition());
+    float rotation = GetRotation();
+
+    // nothing that decides where the pixels go has changed
+    if (m_HasRasterTransform && centerPixelWorld == m_RasterCenter &&
+        rotation == m_RasterRotation)
+        return;
+    m_HasRasterTransform = true;
+    m_RasterCenter = centerPixelWorld;
+    m_RasterRotation = rotation;
 
-    float angle = GetRotation();
+    float angle = rotation;
     // I'm going to convert radians to always be positive.
     if (angle < 0)
         angle += (3.14159265f * 2.0f);
@@ -166,9 +335,11 @@ void PixelBody2D::UpdateElementWorldPositions() {
     float A = -std::tan(angle / 2);
     float B = std::sin(angle);
 
-    for (auto &mappedElement : m_Elements) {
+    m_PreviousWorldPositions.clear();
+    m_PreviousWorldPositions.reserve(m_ElementCount);
+    ForEachBodyElement([&](glm::ivec2 localPos, PixelBodyElement &pbe) {
         // start position
-        glm::ivec2 skewedPos = mappedElement.first * rotationMatrix;
+        glm::ivec2 skewedPos = localPos * rotationMatrix;
 
         //  horizontal skew:
         int horizontalSkewAmount = glm::round((float)skewedPos.y * A);
@@ -180,11 +351,12 @@ void PixelBody2D::UpdateElementWorldPositions() {
         horizontalSkewAmount = glm::round((float)skewedPos.y * A);
         skewedPos.x += horizontalSkewAmount;
 
-        glm::ivec2 posPrior = mappedElement.second.worldPos;
-        mappedElement.second.worldPos = skewedPos + centerPixelWorld;
-        if (posPrior != mappedElement.second.worldPos)
+        glm::ivec2 posPrior = pbe.worldPos;
+        m_PreviousWorldPositions.push_back(posPrior);
+        pbe.worldPos = skewedPos + centerPixelWorld;
+        if (posPrior != pbe.worldPos)
             m_Moved = true;
-    }
+    });
 }
 
 glm::mat4 PixelBody2D::GetWorldTransform() {
@@ -2,8 +2,9 @@
 
 #include "Element.h"
 #include "Pyxis/Game/PhysicsBody2D.h"
-#include "VectorHash.h"
+#include <Pyxis/Core/BinaryGreedyMesh.h>
 #include <Pyxis/Nodes/PhysicsBodyNode2D.h>
+#include <bit>
 
 /// A pixel body is a rigidbody2D , aka a B2Body.
 ///
@@ -61,19 +62,57 @@ class PixelBody2D : public PhysicsBodyNode2D {
     bool m_InWorld = true;
     bool m_Moved =
         false; // track if any elements moved during position updates.
+    // awake bodies are checked after the physics step, to see if their
+    // pixels have to follow the transform
+    bool m_NeedsPush = false;
+
+    // the transform the element world positions were last worked out from.
+    // a body that hasn't turned or crossed into another pixel keeps them.
+    bool m_HasRasterTransform = false;
+    glm::ivec2 m_RasterCenter = {0, 0};
+    float m_RasterRotation = 0.0f;
+    // where each element was before UpdateElementWorldPositions moved it, in
+    // ForEachBodyElement order. only filled in when m_Moved.
+    std::vector<glm::ivec2> m_PreviousWorldPositions;
 
     int m_Width = 0;
     int m_Height = 0;
 
-    // Data needed for bit arrays
+    // the local position of the first cell of the element grid
     glm::ivec2 m_LocalMinimum = {0, 0};
-    std::unordered_map<glm::ivec2, std::vector<uint64_t>, VectorHash>
-        m_BitArrays;
 
     /// <summary>
-    /// m_Elements holds the LOCAL positions about the center.
+    /// The collider is meshed in bands of 64 rows that run the whole width
+    /// of the body, one word of each column, and quads are then joined
+    /// across the band seams.
+    ///
+    /// Each band keeps its quads and the first column changed since, so
+    /// only the changed part of a band is meshed again. m_Quads are the
+    /// joined quads, with the shape made from each in m_Shapes, so only the
+    /// shapes of quads that changed are touched.
+    /// </summary>
+    std::vector<std::vector<BGMQuad>> m_BandQuads;
+    std::vector<int> m_BandDirtyColumns;
+    std::vector<uint64_t> m_BandColumns;
+    std::vector<BGMQuad> m_Quads;
+    std::vector<BGMQuad> m_PreviousQuads;
+    std::vector<b2ShapeId> m_Shapes;
+    // set when the body has shapes that aren't in m_Shapes, like after
+    // deserializing, so they all have to be removed first
+    bool m_NeedsFullMesh = false;
+
+    /// <summary>
+    /// m_Elements is a dense m_Width x m_Height grid, column by column,
+    /// starting at m_LocalMinimum. Local positions are about the center.
+    ///
+    /// m_Occupancy marks which cells hold an element, one bit per cell, with
+    /// m_WordsPerColumn words for each column. Word w of every column makes
+    /// up band w of the collider mesh.
     /// </summary>
-    std::unordered_map<glm::ivec2, PixelBodyElement, VectorHash> m_Elements;
+    std::vector<PixelBodyElement> m_Elements;
+    std::vector<uint64_t> m_Occupancy;
+    int m_WordsPerColumn = 0;
+    size_t m_ElementCount = 0;
     bool m_PixelsChanged = false;
 
     bool m_DebugDisplay = false;
@@ -107,7 +146,9 @@ class PixelBody2D : public PhysicsBodyNode2D {
     virtual void QueueFree() override;
 
     void GenerateMesh();
-    void UpdateBitArrays();
+    // remeshes only the columns that lost or gained elements since the last
+    // mesh
+    void UpdateMesh();
 
     // virtual void OnUpdate(Timestep ts) override;
     // virtual void OnFixedUpdate() override;
@@ -115,7 +156,8 @@ class PixelBody2D : public PhysicsBodyNode2D {
 
     /// <summary>
     /// Uses the physics body to update where the elements would be in the
-    /// world.
+    /// world. Does nothing if the body hasn't turned or changed pixel since
+    /// the last call.
     /// </summary>
     void UpdateElementWorldPositions();
 
@@ -135,8 +177,59 @@ class PixelBody2D : public PhysicsBodyNode2D {
     friend class World;
     inline void ActuallyQueueFree() { PhysicsBodyNode2D::QueueFree(); }
 
+    // empties the element grid, and sizes it for the given local area
+    void ResetElements(glm::ivec2 localMinimum, int width, int height);
+
+    inline bool HasBodyElement(glm::ivec2 localPos) const {
+        glm::ivec2 cell = localPos - m_LocalMinimum;
+        if (cell.x < 0 || cell.y < 0 || cell.x >= m_Width ||
+            cell.y >= m_Height)
+            return false;
+        return (m_Occupancy[cell.x * m_WordsPerColumn + (cell.y / 64)] >>
+                (cell.y % 64)) &
+               1;
+    }
+    // the element has to be there, see HasBodyElement
+    inline PixelBodyElement &GetBodyElement(glm::ivec2 localPos) {
+        glm::ivec2 cell = localPos - m_LocalMinimum;
+        return m_Elements[cell.x * m_Height + cell.y];
+    }
+    // the position has to be inside the grid
+    void SetBodyElement(glm::ivec2 localPos, const PixelBodyElement &pbe);
+    void RemoveBodyElement(glm::ivec2 localPos);
+    inline size_t GetElementCount() const { return m_ElementCount; }
+
+    /// <summary>
+    /// Removes every element that isn't connected to the biggest connected
+    /// part of the body anymore, and returns their world positions.
+    /// </summary>
+    std::vector<glm::ivec2> RemoveDisconnectedElements();
+
+    /// <summary>
+    /// Calls func(localPos, element) for every element, column by column, so
+    /// the order is the same on every machine.
+    /// </summary>
+    template <typename Func> void ForEachBodyElement(Func &&func) {
+        for (int x = 0; x < m_Width; x++) {
+            for (int word = 0; word < m_WordsPerColumn; word++) {
+                uint64_t bits = m_Occupancy[x * m_WordsPerColumn + word];
+                while (bits) {
+                    int y = word * 64 + std::countr_zero(bits);
+                    bits &= bits - 1;
+                    func(m_LocalMinimum + glm::ivec2(x, y),
+                         m_Elements[x * m_Height + y]);
+                }
+            }
+        }
+    }
+
   private:
     glm::vec2 GetLocalPixelVelocity(glm::ivec2 localPosition);
+
+    inline void MarkColumnDirty(glm::ivec2 cell) {
+        int &dirtyColumn = m_BandDirtyColumns[cell.y / 64];
+        dirtyColumn = std::min(dirtyColumn, cell.x);
+    }
 };
 
 REGISTER_SERIALIZABLE_NODE(PixelBody2D);
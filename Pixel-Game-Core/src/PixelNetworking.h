@@ -55,6 +55,7 @@ namespace Pyxis
 		Input_Place,
 		Input_StepSimulation,
 		Input_MousePosition,
+		Input_CameraPosition,
 
 	};
 
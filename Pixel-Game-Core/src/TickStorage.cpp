@@ -0,0 +1,140 @@
+#include "TickStorage.h"
+
+namespace Pyxis {
+
+TickStorage::TickStorage(size_t capacity, size_t maxMemoryBytes,
+                         size_t maxSpilledTicks, bool spillToDisk)
+    : m_Slots(capacity), m_MaxMemoryBytes(maxMemoryBytes),
+      m_SpillToDisk(spillToDisk), m_MaxSpilledTicks(maxSpilledTicks),
+      m_SegmentTicks(std::max<size_t>(maxSpilledTicks / 4, 1)) {
+    PX_ASSERT(capacity > 0, "Tick storage needs room for at least one tick");
+    m_LogDirectory = std::filesystem::temp_directory_path() / "PyxisTicks" /
+                     std::to_string(CreateUUID());
+}
+
+TickStorage::~TickStorage() { Clear(); }
+
+void TickStorage::Store(uint64_t tick, const Ref<std::string> &payload) {
+    if (m_Empty) {
+        m_OldestInMemory = tick;
+        m_NextTick = tick;
+        m_Empty = false;
+    }
+    PX_ASSERT(tick == m_NextTick, "Ticks have to be stored in order");
+
+    if (m_NextTick - m_OldestInMemory == m_Slots.size())
+        EvictOldest();
+    m_Slots[tick % m_Slots.size()] = payload;
+    m_MemoryBytes += payload->size();
+    m_NextTick++;
+
+    // always keep the newest one, however big it is
+    while (m_MemoryBytes > m_MaxMemoryBytes &&
+           m_NextTick - m_OldestInMemory > 1) {
+        EvictOldest();
+    }
+}
+
+Ref<std::string> TickStorage::Get(uint64_t tick) {
+    if (m_Empty)
+        return nullptr;
+    if (tick >= m_OldestInMemory && tick < m_NextTick)
+        return m_Slots[tick % m_Slots.size()];
+
+    if (!m_SpillToDisk || m_Segments.empty() ||
+        tick < m_Segments.front().m_FirstTick)
+        return nullptr;
+    size_t index = (tick - m_Segments.front().m_FirstTick) / m_SegmentTicks;
+    if (index >= m_Segments.size())
+        return nullptr;
+    LogSegment &segment = m_Segments[index];
+    if (tick - segment.m_FirstTick >= segment.m_Offsets.size())
+        return nullptr;
+
+    std::fstream &log = segment.m_File;
+    log.flush();
+    log.seekg(segment.m_Offsets[tick - segment.m_FirstTick]);
+    uint32_t size = 0;
+    log.read(reinterpret_cast<char *>(&size), sizeof(size));
+    Ref<std::string> payload = CreateRef<std::string>(size, '\0');
+    log.read(payload->data(), size);
+    if (!log) {
+        PX_ERROR("Couldn't read tick {0} back from disk", tick);
+        log.clear();
+        return nullptr;
+    }
+    return payload;
+}
+
+void TickStorage::Clear() {
+    for (auto &slot : m_Slots) {
+        slot.reset();
+    }
+    m_MemoryBytes = 0;
+    m_Empty = true;
+
+    m_Segments.clear();
+    m_SpilledTicks = 0;
+    std::error_code error;
+    std::filesystem::remove_all(m_LogDirectory, error);
+}
+
+void TickStorage::EvictOldest() {
+    Ref<std::string> &slot = m_Slots[m_OldestInMemory % m_Slots.size()];
+    if (m_SpillToDisk)
+        Spill(m_OldestInMemory, *slot);
+    m_MemoryBytes -= slot->size();
+    slot.reset();
+    m_OldestInMemory++;
+}
+
+void TickStorage::Spill(uint64_t tick, const std::string &payload) {
+    if (m_Segments.empty() ||
+        m_Segments.back().m_Offsets.size() == m_SegmentTicks) {
+        std::error_code error;
+        std::filesystem::create_directories(m_LogDirectory, error);
+        LogSegment &segment = m_Segments.emplace_back();
+        segment.m_Path = m_LogDirectory / (std::to_string(tick) + ".log");
+        segment.m_FirstTick = tick;
+        segment.m_File.open(segment.m_Path, std::ios::in | std::ios::out |
+                                                std::ios::binary |
+                                                std::ios::trunc);
+    }
+
+    LogSegment &segment = m_Segments.back();
+    std::fstream &log = segment.m_File;
+    log.seekp(0, std::ios::end);
+    uint64_t offset = static_cast<uint64_t>(log.tellp());
+    uint32_t size = static_cast<uint32_t>(payload.size());
+    log.write(reinterpret_cast<const char *>(&size), sizeof(size));
+    log.write(payload.data(), size);
+    if (!log) {
+        // without the log, everything older than memory is gone
+        PX_ERROR("Couldn't write tick {0} to disk, no longer spilling ticks",
+                 tick);
+        StopSpilling();
+        return;
+    }
+    segment.m_Offsets.push_back(offset);
+    m_SpilledTicks++;
+
+    // past the cap, the oldest segment goes, and its ticks with it
+    while (m_SpilledTicks > m_MaxSpilledTicks && !m_Segments.empty()) {
+        LogSegment &oldest = m_Segments.front();
+        m_SpilledTicks -= oldest.m_Offsets.size();
+        oldest.m_File.close();
+        std::error_code error;
+        std::filesystem::remove(oldest.m_Path, error);
+        m_Segments.pop_front();
+    }
+}
+
+void TickStorage::StopSpilling() {
+    m_SpillToDisk = false;
+    m_Segments.clear();
+    m_SpilledTicks = 0;
+    std::error_code error;
+    std::filesystem::remove_all(m_LogDirectory, error);
+}
+
+} // namespace Pyxis
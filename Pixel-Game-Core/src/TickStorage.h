@@ -0,0 +1,80 @@
+#pragma once
+
+#include <Pyxis.h>
+#include <deque>
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <vector>
+
+namespace Pyxis {
+
+/// <summary>
+/// Keeps the compressed merged tick closures the host has sent, so a client
+/// that lost one can ask for it again.
+///
+/// Recent ticks live in a ring indexed by tick number. A tick leaves memory
+/// once the ring wraps around onto it, or sooner if the ring holds more bytes
+/// than allowed. Ticks that leave memory are appended to a log on disk when
+/// spilling is on, so even long gaps can be recovered, just more slowly.
+///
+/// The log is split into segment files of a fixed number of ticks. Once more
+/// than maxSpilledTicks are on disk, the oldest segment is deleted, so a long
+/// running host only ever keeps so much.
+/// </summary>
+class TickStorage {
+  public:
+    TickStorage(size_t capacity, size_t maxMemoryBytes,
+                size_t maxSpilledTicks, bool spillToDisk = true);
+    ~TickStorage();
+
+    TickStorage(const TickStorage &) = delete;
+    TickStorage &operator=(const TickStorage &) = delete;
+
+    // ticks have to be stored in order, one after the other
+    void Store(uint64_t tick, const Ref<std::string> &payload);
+    // the payload for the tick, read back from disk if it was spilled.
+    // nullptr if the tick was never stored or is gone for good.
+    Ref<std::string> Get(uint64_t tick);
+
+    // forgets every tick, and deletes the log
+    void Clear();
+
+    size_t GetMemoryBytes() const { return m_MemoryBytes; }
+
+  private:
+    // one file of the log, holding consecutive ticks from m_FirstTick on, at
+    // these offsets
+    struct LogSegment {
+        std::filesystem::path m_Path;
+        std::fstream m_File;
+        uint64_t m_FirstTick = 0;
+        std::vector<uint64_t> m_Offsets;
+    };
+
+    // moves the oldest tick in memory out of the ring
+    void EvictOldest();
+    void Spill(uint64_t tick, const std::string &payload);
+    // deletes every segment, and stops spilling
+    void StopSpilling();
+
+    std::vector<Ref<std::string>> m_Slots;
+    size_t m_MaxMemoryBytes;
+    size_t m_MemoryBytes = 0;
+
+    // ticks [m_OldestInMemory, m_NextTick) are in the ring
+    uint64_t m_OldestInMemory = 0;
+    uint64_t m_NextTick = 0;
+    bool m_Empty = true;
+
+    // the spilled ticks, oldest segment first. every segment but the last is
+    // full, so a tick's segment can be worked out from its number.
+    bool m_SpillToDisk;
+    std::filesystem::path m_LogDirectory;
+    std::deque<LogSegment> m_Segments;
+    size_t m_MaxSpilledTicks;
+    size_t m_SegmentTicks;
+    size_t m_SpilledTicks = 0;
+};
+
+} // namespace Pyxis
@@ -2,9 +2,9 @@
 #include "Element.h"
 #include "Pyxis/Game/PhysicsBody2D.h"
 #include "Pyxis/Renderer/Renderer2D.h"
-// #include "ChunkWorker.h"
 #include <Pyxis/Game/Physics2D.h>
 #include <glm/gtc/matrix_transform.hpp>
+#include <optional>
 #include <poly2tri.h>
 #include <random>
 #include <tinyxml2.h>
@@ -88,6 +88,8 @@ World::World(std::string assetPath, int seed) {
 }
 
 void World::Initialize(int worldSeed) {
+    // anything generated ahead of time used the old noise
+    DropPrefetchedChunks();
     m_HeightNoise = FastNoiseLite(m_WorldSeed);
     m_CaveNoise = FastNoiseLite(m_WorldSeed);
 }
@@ -121,9 +123,10 @@ void World::DownloadWorldInit(Network::Message &msg) {
     Initialize(m_WorldSeed);
     msg >> m_UpdateBit;
     msg >> m_SimulationTick;
+    msg >> m_StreamingAnchors;
 }
 
-void World::DownloadWorld(Network::Message &msg) {
+uint32_t World::DownloadWorld(Network::Message &msg) {
     if ((GameMessage)msg.header.id == GameMessage::Server_GameDataRigidBody) {
         // lets load the pixel body! just reverse the upload order.
         std::vector<uint8_t> msgpack;
@@ -133,34 +136,72 @@ void World::DownloadWorld(Network::Message &msg) {
             dynamic_pointer_cast<PixelBody2D>(Node::DeserializeNode(j));
         if (PixelBodyNode)
             m_PixelBodies[PixelBodyNode->GetUUID()] = PixelBodyNode;
+        return 1;
     }
     if ((GameMessage)msg.header.id == GameMessage::Server_GameDataChunk) {
-        glm::ivec2 chunkPos;
-        msg >> chunkPos;
-
-        PX_ASSERT(m_Chunks.find(chunkPos) == m_Chunks.end(),
-                  "Tried to load a chunk that already existed");
-        Chunk *chunk = new Chunk(chunkPos);
-        msg >> chunk->m_MeshChanged;
-        msg >> chunk->m_DirtyRect;
-        m_Chunks[chunkPos] = chunk;
-        for (int ii = (CHUNKSIZE * CHUNKSIZE) - 1; ii >= 0; ii--) {
-            msg >> chunk->m_Elements[ii];
+        uint32_t chunkCount;
+        msg >> chunkCount;
+
+        m_NewChunks.clear();
+        m_ChunksToGenerate.clear();
+        std::vector<SnapshotEncoding> encodings(chunkCount);
+        std::vector<std::vector<uint8_t>> snapshots(chunkCount);
+        for (uint32_t i = 0; i < chunkCount; i++) {
+            glm::ivec2 chunkPos;
+            msg >> chunkPos;
+            PX_ASSERT(m_Chunks.find(chunkPos) == m_Chunks.end(),
+                      "Tried to load a chunk that already existed");
+            Chunk *chunk = AcquireChunk(chunkPos);
+            msg >> chunk->m_DirtyRect;
+            msg >> encodings[i];
+            uint32_t size;
+            msg >> size;
+            snapshots[i].resize(size);
+            msg.PullData(snapshots[i].data(), size);
+
+            InsertChunk(chunk);
+            m_NewChunks.push_back(chunk);
+            if (encodings[i] == SnapshotEncoding::Delta)
+                m_ChunksToGenerate.push_back(chunk);
         }
 
-        chunk->UpdateWholeTexture();
+        // deltas go on top of the generated chunk, which we make ourselves
+        m_ChunkWorker.Dispatch(m_ChunksToGenerate.size(), [this](size_t i) {
+            GenerateChunk(m_ChunksToGenerate[i]);
+        });
+
+        for (uint32_t i = 0; i < chunkCount; i++) {
+            Chunk *chunk = m_NewChunks[i];
+            bool decoded = encodings[i] == SnapshotEncoding::Delta
+                               ? ChunkCodec::DecodeDelta(snapshots[i], *chunk)
+                               : ChunkCodec::Decode(snapshots[i], *chunk);
+            if (!decoded)
+                PX_ERROR("Couldn't decode downloaded chunk ({0},{1})",
+                         chunk->m_ChunkPos.x, chunk->m_ChunkPos.y);
+
+            // we don't have a collider for it yet either way
+            chunk->m_MeshChanged = true;
+            chunk->UpdateWholeTexture();
+            WakeChunk(chunk);
+        }
 
-        PX_TRACE("Loaded Chunk ({0},{1})", chunkPos.x, chunkPos.y);
+        PX_TRACE("Loaded {0} Chunks", chunkCount);
+        return chunkCount;
     }
+    return 0;
 }
 
 void World::GetGameDataInit(Network::Message &msg) {
     PX_TRACE("Gathering World Data");
+    // joining clients need the whole world, including what has been evicted
+    LoadAllEvictedChunks();
     msg.header.id = static_cast<uint32_t>(GameMessage::Server_GameDataInit);
     msg << static_cast<uint32_t>(m_Chunks.size());
     PX_TRACE("# Chunks: {0}", m_Chunks.size());
     msg << static_cast<uint32_t>(m_PixelBodies.size());
     PX_TRACE("# RigidBodies: {0}", Physics2D::GetWorld().GetBodyCount());
+    // the anchors decide what gets evicted, so they have to match right away
+    msg << m_StreamingAnchors;
     msg << m_SimulationTick;
     msg << m_UpdateBit;
     msg << m_WorldSeed;
@@ -175,17 +216,54 @@ void World::GetGameData(std::vector<Network::Message> &messages) {
         messages.back() << kvp.second->SerializeBinary();
     }
 
-    // now we create a separate message for each chunk
-    for (auto &pair : m_Chunks) {
-        messages.emplace_back();
-        messages.back().header.id =
-            static_cast<uint32_t>(GameMessage::Server_GameDataChunk);
-        for (int i = 0; i < CHUNKSIZE * CHUNKSIZE; i++) {
-            messages.back() << pair.second->m_Elements[i];
+    // encode every chunk as a delta against what GenerateChunk makes for it,
+    // or whole if most of it has changed, so untouched terrain costs next to
+    // nothing. the bases are generated and compared in parallel batches,
+    // into plain planes, so the renderer and physics world never see them.
+    size_t chunkCount = m_ChunkOrder.size();
+    std::vector<SnapshotEncoding> encodings(chunkCount);
+    std::vector<std::vector<uint8_t>> snapshots(chunkCount);
+    std::vector<ChunkPlanes> bases(std::min(s_SnapshotBatchSize, chunkCount));
+    for (size_t batchStart = 0; batchStart < chunkCount;
+         batchStart += s_SnapshotBatchSize) {
+        size_t batchSize =
+            std::min(s_SnapshotBatchSize, chunkCount - batchStart);
+        m_ChunkWorker.Dispatch(batchSize, [&](size_t i) {
+            size_t index = batchStart + i;
+            const Chunk &chunk = *m_ChunkOrder[index];
+            bases[i].ClearPlanes();
+            GenerateChunk(chunk.m_ChunkPos, bases[i]);
+            int changed =
+                ChunkCodec::EncodeDelta(chunk, bases[i], snapshots[index]);
+            encodings[index] = SnapshotEncoding::Delta;
+            if (changed > (CHUNKSIZE * CHUNKSIZE) / 2) {
+                ChunkCodec::Encode(chunk, snapshots[index]);
+                encodings[index] = SnapshotEncoding::Full;
+            }
+        });
+    }
+
+    // then pack as many chunks into each message as fit
+    uint32_t packed = 0;
+    for (size_t i = 0; i < chunkCount; i++) {
+        if (packed == 0) {
+            messages.emplace_back();
+            messages.back().header.id =
+                static_cast<uint32_t>(GameMessage::Server_GameDataChunk);
+            messages.back().Reserve(s_SnapshotMessageBytes);
+        }
+        Network::Message &msg = messages.back();
+        msg.PushData(snapshots[i].data(), snapshots[i].size());
+        msg << static_cast<uint32_t>(snapshots[i].size());
+        msg << encodings[i];
+        msg << m_ChunkOrder[i]->m_DirtyRect;
+        msg << m_ChunkOrder[i]->m_ChunkPos;
+        packed++;
+
+        if (i + 1 == chunkCount || msg.size() >= s_SnapshotMessageBytes) {
+            msg << packed;
+            packed = 0;
         }
-        messages.back() << pair.second->m_DirtyRect;
-        messages.back() << pair.second->m_MeshChanged;
-        messages.back() << pair.first;
     }
 }
 
@@ -196,21 +274,60 @@ World::~World() {
     for (auto &pair : m_Chunks) {
         delete (pair.second);
     }
+    std::vector<Chunk *> prefetched;
+    m_ChunkGenerator.TakeAll(prefetched);
+    for (Chunk *chunk : prefetched) {
+        delete chunk;
+    }
+    for (Chunk *chunk : m_ChunkPool) {
+        delete chunk;
+    }
 }
 
 Chunk *World::AddChunk(const glm::ivec2 &chunkPos) {
     // make sure chunk doesn't already exist
-    if (m_Chunks.find(chunkPos) == m_Chunks.end()) {
-        Chunk *chunk = new Chunk(chunkPos);
-        m_Chunks[chunkPos] = chunk;
-        GenerateChunk(chunk);
-        chunk->UpdateWholeTexture();
-        return chunk;
-    }
+    auto it = m_Chunks.find(chunkPos);
+    if (it != m_Chunks.end())
+        return it->second;
 
+    AddChunks(std::span<const glm::ivec2>(&chunkPos, 1));
     return m_Chunks[chunkPos];
 }
 
+void World::AddChunks(std::span<const glm::ivec2> chunkPositions) {
+    m_NewChunks.clear();
+    m_ChunksToGenerate.clear();
+    for (const glm::ivec2 &chunkPos : chunkPositions) {
+        if (m_Chunks.contains(chunkPos))
+            continue;
+        // use the prefetched chunk if there is one, it may already be done
+        bool generated = false;
+        Chunk *chunk = m_ChunkGenerator.Take(chunkPos, generated);
+        if (chunk == nullptr)
+            chunk = AcquireChunk(chunkPos);
+        // chunks that were evicted come back exactly as they left, only their
+        // collider has to be rebuilt. one that can't be read back may be
+        // half overwritten, so it starts over before being generated.
+        if (!generated && !m_ChunkStorage.Load(chunkPos, *chunk)) {
+            if (m_ChunkStorage.Contains(chunkPos))
+                chunk->Reset(chunkPos);
+            m_ChunksToGenerate.push_back(chunk);
+        }
+        InsertChunk(chunk);
+        m_NewChunks.push_back(chunk);
+    }
+
+    m_ChunkWorker.Dispatch(m_ChunksToGenerate.size(), [this](size_t i) {
+        GenerateChunk(m_ChunksToGenerate[i]);
+    });
+
+    for (Chunk *chunk : m_NewChunks) {
+        chunk->UpdateWholeTexture();
+        // new chunks still need their collider built
+        WakeChunk(chunk);
+    }
+}
+
 Chunk *World::GetChunk(const glm::ivec2 &chunkPos) {
     auto it = m_Chunks.find(chunkPos);
     if (it != m_Chunks.end())
@@ -221,81 +338,118 @@ Chunk *World::GetChunk(const glm::ivec2 &chunkPos) {
     return m_Chunks[chunkPos];*/
 }
 
+Chunk *World::AcquireChunk(const glm::ivec2 &chunkPos) {
+    if (m_ChunkPool.empty())
+        return new Chunk(chunkPos);
+
+    Chunk *chunk = m_ChunkPool.back();
+    m_ChunkPool.pop_back();
+    chunk->Reset(chunkPos);
+    return chunk;
+}
+
+void World::ReleaseChunk(Chunk *chunk) {
+    chunk->Unlink();
+    chunk->m_Awake = false;
+    chunk->DisablePhysicsBody();
+    if (m_ChunkPool.size() >= s_MaxPooledChunks) {
+        delete chunk;
+        return;
+    }
+    m_ChunkPool.push_back(chunk);
+}
+
+void World::InsertChunk(Chunk *chunk) {
+    m_Chunks[chunk->m_ChunkPos] = chunk;
+    auto it = std::lower_bound(m_ChunkOrder.begin(), m_ChunkOrder.end(),
+                               chunk->m_ChunkPos,
+                               [](Chunk *a, const glm::ivec2 &b) {
+                                   return IVec2Compare()(a->m_ChunkPos, b);
+                               });
+    m_ChunkOrder.insert(it, chunk);
+    LinkChunk(chunk);
+    chunk->CreateTexture();
+    chunk->EnablePhysicsBody();
+}
+
+void World::LinkChunk(Chunk *chunk) {
+    for (int dy = -1; dy <= 1; dy++) {
+        for (int dx = -1; dx <= 1; dx++) {
+            if (dx == 0 && dy == 0)
+                continue;
+            Chunk *neighbor = GetChunk(chunk->m_ChunkPos + glm::ivec2(dx, dy));
+            chunk->SetNeighbor(dx, dy, neighbor);
+        }
+    }
+}
+
 void World::GenerateChunk(Chunk *chunk) {
-    glm::vec2 chunkPixelPos = chunk->m_ChunkPos * CHUNKSIZE;
+    GenerateChunk(chunk->m_ChunkPos, *chunk);
+    chunk->UpdateBitArray();
+}
+
+void World::GenerateChunk(const glm::ivec2 &chunkPos, ChunkPlanes &planes) {
+    const float amplitude = 20.0f;
+    const float grassWidth = 20;
+    glm::ivec2 chunkPixelPos = chunkPos * CHUNKSIZE;
     for (int x = 0; x < CHUNKSIZE; x++) {
-        for (int y = 0; y < CHUNKSIZE; y++) {
-            glm::vec2 pixelPos = chunkPixelPos + glm::vec2(x, y);
-            if (pixelPos.y >= 0) {
-                float amplitude = 20.0f;
-                float heightNoise =
-                    ((m_HeightNoise.GetNoise(pixelPos.x, 0.0f) + 1) / 2) *
-                    amplitude;
-                float surfaceTop = heightNoise + 80;
-                float grassWidth = 20;
-                if (pixelPos.y > surfaceTop + grassWidth) {
-                    // air
-                } else if (pixelPos.y > surfaceTop) {
-                    chunk->SetElement(x, y,
-                                      ElementData::GetElement("grass", x, y));
-                } else if (pixelPos.y > heightNoise) {
-                    // dirt
-                    chunk->SetElement(x, y,
-                                      ElementData::GetElement("dirt", x, y));
-                } else {
-                    // under the noise value, so stone, blended into the caves
-                    float caveNoise =
-                        (m_CaveNoise.GetNoise(pixelPos.x, pixelPos.y) + 1) /
-                        2.0f;
-                    if (caveNoise >= 0.25f) {
-                        chunk->SetElement(
-                            x, y, ElementData::GetElement("stone", x, y));
-                    }
-                }
+        float pixelX = chunkPixelPos.x + x;
+        // the surface only depends on x, so only work it out once per column
+        float heightNoise =
+            ((m_HeightNoise.GetNoise(pixelX, 0.0f) + 1) / 2) * amplitude;
+        float surfaceTop = heightNoise + 80;
 
+        for (int y = 0; y < CHUNKSIZE; y++) {
+            float pixelY = chunkPixelPos.y + y;
+            uint32_t id = SimElementInfo::NoElement;
+            if (pixelY > surfaceTop + grassWidth) {
+                // air, and so is everything above it
+                break;
+            } else if (pixelY > surfaceTop) {
+                id = ElementData::s_GrassID;
+            } else if (pixelY > heightNoise) {
+                id = ElementData::s_DirtID;
             } else {
-                // under y==0, so
+                // under the noise value, so stone, blended into the caves
                 float caveNoise =
-                    (m_CaveNoise.GetNoise(pixelPos.x, pixelPos.y) + 1) / 2.0f;
-                if (caveNoise >= 0.25f) {
-                    chunk->SetElement(x, y,
-                                      ElementData::GetElement("stone", x, y));
-                }
+                    (m_CaveNoise.GetNoise(pixelX, pixelY) + 1) / 2.0f;
+                if (caveNoise >= 0.25f)
+                    id = ElementData::s_StoneID;
             }
+
+            if (id != SimElementInfo::NoElement)
+                planes.SetElement(x, y, ElementData::GetElement(id, x, y));
         }
     }
 }
 
-Element &World::GetElement(const glm::ivec2 &pixelPos) {
+ElementRef World::GetElement(const glm::ivec2 &pixelPos) {
     auto chunkPos = PixelToChunk(pixelPos);
     auto index = PixelToIndex(pixelPos);
     return GetChunk(chunkPos)->GetElement(index);
 }
 
 bool World::TryGetElement(const glm::ivec2 &pixelPos, Element &element) {
-    if (m_Chunks.contains(PixelToChunk(pixelPos))) {
-        element = GetChunk(PixelToChunk(pixelPos))
-                      ->GetElement(PixelToIndex(pixelPos));
+    Chunk *chunk = GetChunk(PixelToChunk(pixelPos));
+    if (chunk != nullptr) {
+        element = chunk->GetElement(PixelToIndex(pixelPos));
         return true;
     }
     return false;
 }
 
-Element &World::ForceGetElement(const glm::ivec2 &pixelPos) {
+ElementRef World::ForceGetElement(const glm::ivec2 &pixelPos) {
     auto chunkPos = PixelToChunk(pixelPos);
     auto index = PixelToIndex(pixelPos);
-    if (!m_Chunks.contains(chunkPos)) {
-        AddChunk(chunkPos);
-    }
-    return GetChunk(chunkPos)->GetElement(PixelToIndex(pixelPos));
+    return AddChunk(chunkPos)->GetElement(index);
 }
 
 void World::SetElement(const glm::ivec2 &pixelPos, const Element &element) {
     Chunk *chunk = GetChunk(PixelToChunk(pixelPos));
     auto index = PixelToIndex(pixelPos);
-    if (element.m_ID == ElementData::s_ElementNameToID["debug_heat"]) {
+    if (element.m_ID == ElementData::s_DebugHeatID) {
         chunk->GetElement(index).m_Temperature++;
-    } else if (element.m_ID == ElementData::s_ElementNameToID["debug_cool"]) {
+    } else if (element.m_ID == ElementData::s_DebugCoolID) {
         chunk->GetElement(index).m_Temperature--;
     } else {
         chunk->SetElement(index.x, index.y, element);
@@ -307,13 +461,16 @@ void World::SetElementWithoutDirtyRectUpdate(const glm::ivec2 &pixelPos,
                                              const Element &element) {
     Chunk *chunk = GetChunk(PixelToChunk(pixelPos));
     auto index = PixelToIndex(pixelPos);
-    if (element.m_ID == ElementData::s_ElementNameToID["debug_heat"]) {
+    if (element.m_ID == ElementData::s_DebugHeatID) {
         chunk->GetElement(index).m_Temperature++;
-    } else if (element.m_ID == ElementData::s_ElementNameToID["debug_cool"]) {
+    } else if (element.m_ID == ElementData::s_DebugCoolID) {
         chunk->GetElement(index).m_Temperature--;
     } else {
         chunk->SetElement(index.x, index.y, element);
     }
+    // the dirty rect is left alone, but the mesh may still need rebuilding
+    if (chunk->m_MeshChanged)
+        WakeChunk(chunk);
 }
 
 void World::PaintBrushElement(glm::ivec2 pixelPos, uint32_t elementID,
@@ -356,15 +513,15 @@ void World::PaintBrushElement(glm::ivec2 pixelPos, uint32_t elementID,
             elementData.UpdateElementProperties(element, index.x, index.y);
 
             // set the element
-            if (element.m_ID == ElementData::s_ElementNameToID["debug_heat"]) {
+            if (element.m_ID == ElementData::s_DebugHeatID) {
                 chunk->GetElement(index).m_Temperature++;
-            } else if (element.m_ID ==
-                       ElementData::s_ElementNameToID["debug_cool"]) {
+            } else if (element.m_ID == ElementData::s_DebugCoolID) {
                 chunk->GetElement(index).m_Temperature--;
             } else {
                 chunk->SetElement(index.x, index.y, element);
             }
             chunk->UpdateDirtyRect(index.x, index.y);
+            WakeChunk(chunk);
         }
     }
     for (auto chunk : chunksToUpdate) {
@@ -392,7 +549,8 @@ void World::PullPixelBodies() {
     }
 
     // we now have a list of bodies that are still alive. Lets iterate over the
-    // list and pull them out.
+    // list and check their elements against the world. The elements stay in
+    // the world, PushPixelBodies only moves the ones the step moved.
     for (Ref<PixelBody2D> body : bodies) {
         // skip if we are sleeping!
         if (!body->GetAwake()) {
@@ -403,16 +561,16 @@ void World::PullPixelBodies() {
         // keep list of elements to take out after iteration
         std ::vector<glm::ivec2> elementsToRemove;
 
-        // loop over all elements, and attempt to take them out of the world
-        for (auto &mappedElement : body->m_Elements) {
-
+        // loop over all elements, and make sure the world still has them
+        body->ForEachBodyElement([&](glm::ivec2 localPos,
+                                     PixelBodyElement &bodyElement) {
             // the world position of the element is already known, so just
             // try to grab it
-            Element &worldElement = GetElement(mappedElement.second.worldPos);
-            ElementProperties &worldElementData =
-                ElementData::GetElementProperties(worldElement.m_ID);
+            ElementRef worldElement = GetElement(bodyElement.worldPos);
+            const SimElementInfo &worldElementData =
+                ElementData::GetSimInfo(worldElement.m_ID);
 
-            if (mappedElement.second.element.m_ID !=
+            if (bodyElement.element.m_ID !=
                 worldElement
                     .m_ID) // || !worldElement.m_Rigid TODO re-implement rigid?
             {
@@ -427,178 +585,164 @@ void World::PullPixelBodies() {
                     // stays solid, like getting stained or something idk
                     // either way, in this situation we just pull the new
                     // element
-                    mappedElement.second.element = worldElement;
-                    mappedElement.second.element.m_Rigid = true;
-                    SetElementWithoutDirtyRectUpdate(
-                        mappedElement.second.worldPos, Element());
+                    bodyElement.element = worldElement;
+                    bodyElement.element.m_Rigid = true;
+                    SetElementWithoutDirtyRectUpdate(bodyElement.worldPos,
+                                                     bodyElement.element);
                 } else {
                     // the element that has taken over the spot is not able
                     // to be a solid, so we need to re-construct the rigid
                     // body without that element! so we leave it in the sim,
                     // and erase the previous from the body
-                    elementsToRemove.push_back(mappedElement.first);
+                    elementsToRemove.push_back(localPos);
                 }
             } else {
-                // element should be the same, so nothing has changed, pull
-                // the element out
-                // PX_TRACE("pulling out pbe ({0},{1})",
-                //         mappedElement.second.worldPos.x,
-                //         mappedElement.second.worldPos.y);
-                mappedElement.second.element = worldElement;
-                // replace with default element
-                SetElementWithoutDirtyRectUpdate(mappedElement.second.worldPos,
-                                                 Element());
+                // element should be the same, so nothing has changed, just
+                // keep up with its temperature and such
+                bodyElement.element = worldElement;
             }
-        }
+        });
 
-        // now that we pulled all the elements out, try to re-construct the
+        // now that we checked all the elements, try to re-construct the
         // body if needed:
         if (elementsToRemove.size() > 0) {
             // we need to reconstruct!
             // remove the outdated elements
             for (auto &localPos : elementsToRemove) {
-                body->m_Elements.erase(localPos);
+                body->RemoveBodyElement(localPos);
             }
 
-            // gather up local positions of elements
-            std::unordered_set<glm::ivec2, VectorHash> source;
-            for (auto kvp : body->m_Elements) {
-                source.insert(kvp.first);
-            }
-
-            // get a continuous section of the local positions
-            auto firstPull = Utils::GridQueuePull(source);
-            // firstpull should be the main body, as it may still be fully
-            // intact! let's remove whats in source if there's any
-            // straglers, and make it into it's own body.
-
-            std::unordered_set<glm::ivec2, VectorHash> pixels;
-            for (glm::ivec2 pos : source) {
-                // source is now what is remaining after pulling out a
-                // continuous set.
-
-                // put the remainder back into the world
-                SetElementWithoutDirtyRectUpdate(body->m_Elements[pos].worldPos,
-                                                 body->m_Elements[pos].element);
-
-                // lets remove that remainder from this
-                // pixelbody, and make new pixel bodies from it after.
-                // we also need to track the world positions for the
-                // creation of the remainder.
-                pixels.insert(body->m_Elements[pos].worldPos);
-                body->m_Elements.erase(pos);
-            }
+            // the biggest connected part stays the main body, as it may
+            // still be fully intact! whatever got cut off from it is taken
+            // out of this body, and made into bodies of its own. It is still
+            // in the world.
+            std::vector<glm::ivec2> remainder =
+                body->RemoveDisconnectedElements();
 
             // create the new pixel bodies from the remainder.
-            if (pixels.size() > 0) {
+            if (remainder.size() > 0) {
                 PhysicsBody2DDef def;
                 def.type = body->GetType();
                 def.linearVelocity = body->GetLinearVelocity();
                 def.angularVelocity = body->GetAngularVelocity();
-                auto newBody =
-                    CreatePixelBody(def, pixels, true, body->m_Name + "-Split");
+                auto newBody = CreatePixelBody(def, remainder, true,
+                                               body->m_Name + "-Split");
             }
 
-            if (body->m_Elements.size() == 0) {
+            if (body->GetElementCount() == 0) {
                 body->QueueFree();
                 body->RemoveShapes();
 
             } else {
-                // recalculate the bitarrays and collider/mesh
-                body->GenerateMesh();
+                // only the columns that lost elements are meshed again
+                body->UpdateMesh();
             }
         }
-        // End off with saying this body is no longer in the world. We may even
-        // be dead!
-        body->m_InWorld = false;
+        // the step may move us, so check again after it. We may even be
+        // dead!
+        body->m_NeedsPush = true;
     }
 }
 
 void World::PushPixelBodies() {
-    // put the elements back into the simulation.
-    // no need to copy list, as we won't change it here.
-    for (auto kvp : m_PixelBodies) {
+    // work out where every body that may have moved goes now. bodies that
+    // still land on the same pixels are left alone entirely.
+    std::vector<Ref<PixelBody2D>> movedBodies;
+    for (auto &kvp : m_PixelBodies) {
         Ref<PixelBody2D> body = kvp.second;
-        // PX_TRACE("Pushing PixelBody2D[{}] back into world", kvp.first);
-        // PX_TRACE("Position: ({0},{1})", body->GetPosition().x,
-        //          body->GetPosition().y);
-        if (body->m_InWorld) {
-            // PX_TRACE("Skipping because its still in world!");
-            // this would include bodies made during last pull as in world is
-            // default
-            continue; // body is already in world
-        }
+        if (!body->m_NeedsPush)
+            continue;
+        body->m_NeedsPush = false;
+        body->UpdateElementWorldPositions();
+        if (body->m_Moved)
+            movedBodies.push_back(body);
+    }
+    if (movedBodies.empty())
+        return;
 
-        // chunkloading
+    // chunkloading, all at once so new chunks generate in parallel
+    std::vector<glm::ivec2> chunksToLoad;
+    for (auto &body : movedBodies) {
+        glm::ivec2 bodyChunk = PixelToChunk(WorldToPixel(body->GetPosition()));
         for (int x = -1; x < 2; x++) {
             for (int y = -1; y < 2; y++) {
-                AddChunk(PixelToChunk(WorldToPixel(body->GetPosition())) +
-                         glm::ivec2(x, y));
+                chunksToLoad.push_back(bodyChunk + glm::ivec2(x, y));
             }
         }
+    }
+    AddChunks(chunksToLoad);
+
+    // take every pixel that moved out of its old spot first, so bodies
+    // moving into each other's old spots don't knock each other out
+    for (auto &body : movedBodies) {
+        size_t index = 0;
+        body->ForEachBodyElement(
+            [&](glm::ivec2 localPos, PixelBodyElement &bodyElement) {
+                glm::ivec2 previous = body->m_PreviousWorldPositions[index++];
+                if (previous != bodyElement.worldPos)
+                    SetElementWithoutDirtyRectUpdate(previous, Element());
+            });
+    }
 
-        // update world positions to put back into new locations
-        body->UpdateElementWorldPositions();
-
-        body->m_InWorld = true;
-        if (body->m_Moved) {
-            for (auto &mappedElement : body->m_Elements) {
-
-                // check if there is an element in the way in the world
-                Element &e = GetElement(mappedElement.second.worldPos);
-                if (e.m_ID != 0)
-                    CreateParticle(
-                        mappedElement.second.worldPos,
-                        body->GetLocalPixelVelocity(mappedElement.first), e);
-
-                // PX_TRACE("putting pbe ({0},{1}) back in",
-                //          mappedElement.second.worldPos.x,
-                //          mappedElement.second.worldPos.y);
-                SetElement(mappedElement.second.worldPos,
-                           mappedElement.second.element);
+    // then put them down in their new spots
+    for (auto &body : movedBodies) {
+        size_t index = 0;
+        body->ForEachBodyElement([&](glm::ivec2 localPos,
+                                     PixelBodyElement &bodyElement) {
+            glm::ivec2 previous = body->m_PreviousWorldPositions[index++];
+            // check if there is an element in the way in the world
+            ElementRef e = GetElement(bodyElement.worldPos);
+
+            if (previous == bodyElement.worldPos) {
+                // this pixel didn't move. it is only missing if another
+                // element of the body just left the same spot
+                if (e.m_ID == 0)
+                    SetElementWithoutDirtyRectUpdate(bodyElement.worldPos,
+                                                     bodyElement.element);
+                return;
             }
-        } else {
-            // we are still, so put back without updating dirty rect
-            // PX_TRACE("we didn't move, so put back in without rect update");
-            for (auto &mappedElement : body->m_Elements) {
-
-                // check if there is an element in the way in the world
-                Element &e = GetElement(mappedElement.second.worldPos);
-
-                if (e.m_ID != 0)
-                    CreateParticle(
-                        mappedElement.second.worldPos,
-                        body->GetLocalPixelVelocity(mappedElement.first), e);
-                //  PX_TRACE("putting pbe ({0},{1}) back in, but still",
-                //           mappedElement.second.worldPos.x,
-                //           mappedElement.second.worldPos.y);
-                SetElementWithoutDirtyRectUpdate(mappedElement.second.worldPos,
-                                                 mappedElement.second.element);
-            }
-        }
+
+            if (e.m_ID != 0)
+                CreateParticle(bodyElement.worldPos,
+                               body->GetLocalPixelVelocity(localPos), e);
+
+            // PX_TRACE("putting pbe ({0},{1}) back in",
+            //          bodyElement.worldPos.x, bodyElement.worldPos.y);
+            SetElement(bodyElement.worldPos, bodyElement.element);
+        });
     }
 }
 
 void World::UpdateWorld() {
-    /*m_Threads.clear();
-    for each (auto& pair in m_Chunks)
-    {
-            m_Threads.push_back(std::thread(&World::UpdateChunk, pair.second));
-    }
-    for each (std::thread& thread in m_Threads)
-    {
-            thread.join();
-    }*/
-
     UpdateParticles();
 
-    for (auto &[pos, chunk] : m_Chunks) {
-        UpdateChunk(chunk);
+    // update the chunks in a checkerboard of four phases. chunks in the same
+    // phase are never next to each other, and an element only ever reaches
+    // into the chunks directly beside it, so each chunk in a phase works on
+    // its own set of elements and can be updated on any thread. the phases
+    // themselves still run one after the other, in the same order everywhere.
+    // only awake chunks are visited. the phase is gathered right before it
+    // runs, so neighbors woken by an earlier phase still update this tick.
+    for (int phase = 0; phase < 4; phase++) {
+        m_PhaseChunks.clear();
+        for (Chunk *chunk : m_ActiveChunks) {
+            glm::ivec2 pos = chunk->m_ChunkPos;
+            if (((pos.x & 1) | ((pos.y & 1) << 1)) == phase)
+                m_PhaseChunks.push_back(chunk);
+        }
+        if (!m_ChunkStorage.Empty()) {
+            for (Chunk *chunk : m_PhaseChunks) {
+                LoadEvictedNeighbors(chunk);
+            }
+        }
+        m_ChunkWorker.Dispatch(m_PhaseChunks.size(), [this](size_t i) {
+            UpdateChunk(m_PhaseChunks[i]);
+        });
     }
 
     if (!m_ServerMode) {
-        for (auto &pair : m_Chunks) {
-            pair.second->UpdateTexture();
+        for (Chunk *chunk : m_ActiveChunks) {
+            chunk->UpdateTexture();
         }
     }
 
@@ -609,15 +753,187 @@ void World::UpdateWorld() {
     PushPixelBodies();
     // put pixelbodies back in
     TestMeshGeneration();
+    SleepSettledChunks();
+    if (m_SimulationTick % s_EvictionInterval == 0)
+        EvictDistantChunks();
+    // generate ahead while the rest of the frame runs
+    PrefetchChunks();
 
     m_UpdateBit = !m_UpdateBit;
     m_SimulationTick++;
 }
 
 void World::UpdateTextures() {
-    for (auto &pair : m_Chunks) {
-        pair.second->UpdateTexture();
+    for (Chunk *chunk : m_ActiveChunks) {
+        chunk->UpdateTexture();
+    }
+}
+
+void World::WakeChunk(Chunk *chunk) {
+    // cheap check first, this is hit for every element that moves
+    if (chunk->m_Awake.load(std::memory_order_relaxed))
+        return;
+    if (chunk->m_Awake.exchange(true))
+        return;
+    std::scoped_lock lock(m_ActiveChunksMutex);
+    m_ActiveChunks.push_back(chunk);
+}
+
+void World::SetStreamingAnchor(HSteamNetConnection clientID,
+                               const glm::vec2 &position) {
+    for (StreamingAnchor &anchor : m_StreamingAnchors) {
+        if (anchor.m_ClientID == clientID) {
+            anchor.m_Position = position;
+            anchor.m_LastTick = m_SimulationTick;
+            return;
+        }
     }
+    m_StreamingAnchors.push_back({clientID, position, m_SimulationTick});
+}
+
+void World::EvictDistantChunks() {
+    std::erase_if(m_StreamingAnchors, [this](const StreamingAnchor &anchor) {
+        return m_SimulationTick - anchor.m_LastTick > s_AnchorTimeout;
+    });
+
+    std::vector<glm::ivec2> anchors;
+    anchors.reserve(m_PixelBodies.size() + m_StreamingAnchors.size());
+    for (auto &kvp : m_PixelBodies) {
+        glm::vec2 position = kvp.second->GetPosition();
+        anchors.push_back(PixelToChunk(WorldToPixel(position)));
+    }
+    for (const StreamingAnchor &anchor : m_StreamingAnchors) {
+        anchors.push_back(PixelToChunk(WorldToPixel(anchor.m_Position)));
+    }
+    // with nothing to stay near, everything would go
+    if (anchors.empty())
+        return;
+
+    std::erase_if(m_ChunkOrder, [&](Chunk *chunk) {
+        // only chunks that have nothing left to do, and whose neighbors don't
+        // either, so no update can reach into them before they are read back
+        for (int i = 0; i < 9; i++) {
+            Chunk *neighbor = chunk->m_Neighbors[i];
+            if (neighbor != nullptr && neighbor->m_Awake)
+                return false;
+        }
+        for (const glm::ivec2 &anchor : anchors) {
+            glm::ivec2 distance = glm::abs(chunk->m_ChunkPos - anchor);
+            if (std::max(distance.x, distance.y) <= s_EvictionRadius)
+                return false;
+        }
+
+        if (!m_ChunkStorage.Store(*chunk))
+            return false;
+        m_Chunks.erase(chunk->m_ChunkPos);
+        ReleaseChunk(chunk);
+        return true;
+    });
+}
+
+void World::LoadEvictedNeighbors(Chunk *chunk) {
+    for (int dy = -1; dy <= 1; dy++) {
+        for (int dx = -1; dx <= 1; dx++) {
+            glm::ivec2 chunkPos = chunk->m_ChunkPos + glm::ivec2(dx, dy);
+            if (chunk->GetNeighbor(dx, dy) == nullptr &&
+                m_ChunkStorage.Contains(chunkPos))
+                AddChunk(chunkPos);
+        }
+    }
+}
+
+void World::LoadAllEvictedChunks() {
+    // AddChunk takes them out of storage, so copy the positions first
+    std::vector<glm::ivec2> stored(m_ChunkStorage.GetStoredChunks().begin(),
+                                   m_ChunkStorage.GetStoredChunks().end());
+    std::sort(stored.begin(), stored.end(), IVec2Compare());
+    AddChunks(stored);
+}
+
+void World::PrefetchChunks() {
+    // gather everything wanted this tick first, so making room for one
+    // position never gives up on another that is still wanted
+    m_PrefetchOrder.clear();
+    m_PrefetchWanted.clear();
+    auto want = [this](const glm::ivec2 &chunkPos) {
+        if (m_PrefetchWanted.insert(chunkPos).second)
+            m_PrefetchOrder.push_back(chunkPos);
+    };
+
+    for (const StreamingAnchor &anchor : m_StreamingAnchors) {
+        glm::ivec2 center = PixelToChunk(WorldToPixel(anchor.m_Position));
+        for (int y = -s_PrefetchRadius; y <= s_PrefetchRadius; y++) {
+            for (int x = -s_PrefetchRadius; x <= s_PrefetchRadius; x++) {
+                want(center + glm::ivec2(x, y));
+            }
+        }
+    }
+
+    // one ring past the 3x3 that PushPixelBodies loads around each body
+    for (auto &kvp : m_PixelBodies) {
+        glm::vec2 position = kvp.second->GetPosition();
+        glm::ivec2 center = PixelToChunk(WorldToPixel(position));
+        for (int y = -s_PrefetchBodyRadius; y <= s_PrefetchBodyRadius; y++) {
+            for (int x = -s_PrefetchBodyRadius; x <= s_PrefetchBodyRadius;
+                 x++) {
+                want(center + glm::ivec2(x, y));
+            }
+        }
+    }
+
+    // particle velocities are in pixels per tick, so look a little ahead
+    // along their path for the chunk they are likely to land in
+    for (const ElementParticle &particle : m_ElementParticles) {
+        glm::vec2 ahead =
+            particle.m_Position + particle.m_Velocity * s_PrefetchParticleTicks;
+        want(PixelToChunk(WorldToPixel(ahead)));
+    }
+
+    for (const glm::ivec2 &chunkPos : m_PrefetchOrder) {
+        // once there is no room left, the rest waits for a later tick
+        if (!PrefetchChunk(chunkPos))
+            return;
+    }
+}
+
+bool World::PrefetchChunk(const glm::ivec2 &chunkPos) {
+    if (m_Chunks.contains(chunkPos) || m_ChunkStorage.Contains(chunkPos) ||
+        m_ChunkGenerator.Contains(chunkPos))
+        return true;
+
+    if (m_ChunkGenerator.Size() >= s_MaxPrefetchedChunks) {
+        // make room by giving up on whatever has been waiting the longest,
+        // as long as nothing wants it anymore
+        Chunk *stale = m_ChunkGenerator.TakeOldestReady(m_PrefetchWanted);
+        if (stale == nullptr)
+            return false;
+        ReleaseChunk(stale);
+    }
+    // the chunk is only reset here, and the generator only fills in its
+    // elements, so prefetching never reaches the renderer or the physics
+    // world
+    m_ChunkGenerator.Request(AcquireChunk(chunkPos));
+    return true;
+}
+
+void World::DropPrefetchedChunks() {
+    std::vector<Chunk *> prefetched;
+    m_ChunkGenerator.TakeAll(prefetched);
+    for (Chunk *chunk : prefetched) {
+        ReleaseChunk(chunk);
+    }
+}
+
+void World::SleepSettledChunks() {
+    std::erase_if(m_ActiveChunks, [](Chunk *chunk) {
+        if (!chunk->IsSettled())
+            return false;
+        // the rect keeps shrinking past itself while it is collapsed, so
+        // put it back to the empty state before the chunk goes to sleep
+        chunk->ResetDirtyRect();
+        chunk->m_Awake = false;
+        return true;
+    });
 }
 
 /// <summary>
@@ -708,9 +1024,9 @@ void World::UpdateChunk(Chunk *chunk) {
                 // we now have an x and y of the element in the array, so update
                 // it
 
-                Element &currElement = chunk->GetElement(x, y);
-                ElementProperties &currElementData =
-                    ElementData::GetElementProperties(currElement.m_ID);
+                ElementRef currElement = chunk->GetElement(x, y);
+                const SimElementInfo &currElementData =
+                    ElementData::GetSimInfo(currElement.m_ID);
 
                 // skip if already updated
                 if (currElement.m_Updated == m_UpdateBit)
@@ -726,14 +1042,11 @@ void World::UpdateChunk(Chunk *chunk) {
 
                 int r = 0;
 
-                // iterators for reaction lookup
-                std::unordered_map<uint32_t, ReactionResult>::iterator it;
-                std::unordered_map<uint32_t, ReactionResult>::iterator end;
-
-                Element *elementTop;
-                Element *elementBottom;
-                Element *elementRight;
-                Element *elementLeft;
+                // neighbors, left empty if their chunk doesn't exist
+                std::optional<ElementRef> elementTop;
+                std::optional<ElementRef> elementBottom;
+                std::optional<ElementRef> elementRight;
+                std::optional<ElementRef> elementLeft;
 
                 Chunk *leftChunk = chunk;
                 Chunk *rightChunk = chunk;
@@ -743,220 +1056,202 @@ void World::UpdateChunk(Chunk *chunk) {
                 // get cardinal elements
                 {
                     if (IsInBounds(x, y + 1)) {
-                        elementTop = &(chunk->GetElement(x, y + 1));
+                        elementTop.emplace(chunk->GetElement(x, y + 1));
                     } else {
                         // see if the chunk exists, if it does then get that
-                        // element, otherwise nullptr
-                        glm::ivec2 pixelSpace = chunk->m_ChunkPos * CHUNKSIZE +
-                                                glm::ivec2(x, y + 1);
-                        topChunk = GetChunk(PixelToChunk(pixelSpace));
+                        // element, otherwise leave it empty
+                        topChunk = chunk->GetHaloChunk(x, y + 1);
                         if (topChunk != nullptr) {
                             int indexOther =
                                 ((((x) + CHUNKSIZE) % CHUNKSIZE) +
                                  (((y + 1) + CHUNKSIZE) % CHUNKSIZE) *
                                      CHUNKSIZE);
-                            elementTop = &(topChunk->GetElement(indexOther));
-                        } else {
-                            elementTop = nullptr;
+                            elementTop.emplace(
+                                topChunk->GetElement(indexOther));
                         }
                     }
 
                     if (IsInBounds(x, y - 1)) {
-                        elementBottom = &(chunk->GetElement(x, y - 1));
+                        elementBottom.emplace(chunk->GetElement(x, y - 1));
                     } else {
                         // see if the chunk exists, if it does then get that
-                        // element, otherwise nullptr
-                        glm::ivec2 pixelSpace = chunk->m_ChunkPos * CHUNKSIZE +
-                                                glm::ivec2(x, y - 1);
-                        bottomChunk = GetChunk(PixelToChunk(pixelSpace));
+                        // element, otherwise leave it empty
+                        bottomChunk = chunk->GetHaloChunk(x, y - 1);
                         if (bottomChunk != nullptr) {
                             int indexOther =
                                 ((((x) + CHUNKSIZE) % CHUNKSIZE) +
                                  (((y - 1) + CHUNKSIZE) % CHUNKSIZE) *
                                      CHUNKSIZE);
-                            elementBottom =
-                                &(bottomChunk->GetElement(indexOther));
-                        } else {
-                            elementBottom = nullptr;
+                            elementBottom.emplace(
+                                bottomChunk->GetElement(indexOther));
                         }
                     }
 
                     if (IsInBounds(x + 1, y)) {
-                        elementRight = &(chunk->GetElement(x + 1, y));
+                        elementRight.emplace(chunk->GetElement(x + 1, y));
                     } else {
                         // see if the chunk exists, if it does then get that
-                        // element, otherwise nullptr
-                        glm::ivec2 pixelSpace = chunk->m_ChunkPos * CHUNKSIZE +
-                                                glm::ivec2(x + 1, y);
-                        rightChunk = GetChunk(PixelToChunk(pixelSpace));
+                        // element, otherwise leave it empty
+                        rightChunk = chunk->GetHaloChunk(x + 1, y);
                         if (rightChunk != nullptr) {
                             int indexOther =
                                 ((((x + 1) + CHUNKSIZE) % CHUNKSIZE) +
                                  (((y) + CHUNKSIZE) % CHUNKSIZE) * CHUNKSIZE);
-                            elementRight =
-                                &(rightChunk->GetElement(indexOther));
-                        } else {
-                            elementRight = nullptr;
+                            elementRight.emplace(
+                                rightChunk->GetElement(indexOther));
                         }
                     }
 
                     if (IsInBounds(x - 1, y)) {
-                        elementLeft = &(chunk->GetElement(x - 1, y));
+                        elementLeft.emplace(chunk->GetElement(x - 1, y));
                     } else {
                         // see if the chunk exists, if it does then get that
-                        // element, otherwise nullptr
-                        glm::ivec2 pixelSpace = chunk->m_ChunkPos * CHUNKSIZE +
-                                                glm::ivec2(x - 1, y);
-                        leftChunk = GetChunk(PixelToChunk(pixelSpace));
+                        // element, otherwise leave it empty
+                        leftChunk = chunk->GetHaloChunk(x - 1, y);
                         if (leftChunk != nullptr) {
                             int indexOther =
                                 ((((x - 1) + CHUNKSIZE) % CHUNKSIZE) +
                                  (((y) + CHUNKSIZE) % CHUNKSIZE) * CHUNKSIZE);
-                            elementLeft = &(leftChunk->GetElement(indexOther));
-                        } else {
-                            elementLeft = nullptr;
+                            elementLeft.emplace(
+                                leftChunk->GetElement(indexOther));
                         }
                     }
                 }
 
-                ElementProperties *elementLeftData =
-                    (elementLeft != nullptr)
-                        ? &ElementData::GetElementProperties(elementLeft->m_ID)
+                const SimElementInfo *elementLeftData =
+                    (elementLeft != std::nullopt)
+                        ? &ElementData::GetSimInfo(elementLeft->m_ID)
                         : nullptr;
-                ElementProperties *elementRightData =
-                    (elementRight != nullptr)
-                        ? &ElementData::GetElementProperties(elementRight->m_ID)
+                const SimElementInfo *elementRightData =
+                    (elementRight != std::nullopt)
+                        ? &ElementData::GetSimInfo(elementRight->m_ID)
                         : nullptr;
-                ElementProperties *elementTopData =
-                    (elementTop != nullptr)
-                        ? &ElementData::GetElementProperties(elementTop->m_ID)
+                const SimElementInfo *elementTopData =
+                    (elementTop != std::nullopt)
+                        ? &ElementData::GetSimInfo(elementTop->m_ID)
                         : nullptr;
-                ElementProperties *elementBottomData =
-                    (elementBottom != nullptr)
-                        ? &ElementData::GetElementProperties(
-                              elementBottom->m_ID)
+                const SimElementInfo *elementBottomData =
+                    (elementBottom != std::nullopt)
+                        ? &ElementData::GetSimInfo(elementBottom->m_ID)
                         : nullptr;
                 // check for reactions, left,up,right,down
                 {
-                    if (elementLeft != nullptr) {
-                        it =
-                            ElementData::s_ReactionTable[currElement.m_ID].find(
-                                elementLeft->m_ID);
-                        end = ElementData::s_ReactionTable[currElement.m_ID]
-                                  .end();
-                        if (it != end && GetRandom() < it->second.probability) {
-                            currElement.m_ID = it->second.cell0ID;
+                    if (elementLeft != std::nullopt) {
+                        const ReactionResult &reaction =
+                            ElementData::GetReaction(currElement.m_ID,
+                                                     elementLeft->m_ID);
+                        if (reaction.probability > 0 &&
+                            GetRandom() < reaction.probability) {
+                            currElement.m_ID = reaction.cell0ID;
                             ElementProperties &ed0 =
                                 ElementData::GetElementProperties(
-                                    it->second.cell0ID);
+                                    reaction.cell0ID);
                             ed0.UpdateElementProperties(currElement, x, y);
-                            if (ed0.cell_type == ElementType::solid ||
-                                ed0.cell_type == ElementType::movableSolid) {
-                                chunk->m_MeshChanged = true;
+                            if (ElementData::IsColliderSolid(
+                                    reaction.cell0ID)) {
+                                chunk->MarkMeshChanged();
                             }
 
-                            elementLeft->m_ID = it->second.cell1ID;
+                            elementLeft->m_ID = reaction.cell1ID;
                             ElementProperties &ed1 =
                                 ElementData::GetElementProperties(
-                                    it->second.cell1ID);
-                            if (ed1.cell_type == ElementType::solid ||
-                                ed1.cell_type == ElementType::movableSolid) {
-                                leftChunk->m_MeshChanged = true;
+                                    reaction.cell1ID);
+                            if (ElementData::IsColliderSolid(
+                                    reaction.cell1ID)) {
+                                leftChunk->MarkMeshChanged();
                             }
-                            ed1.UpdateElementProperties(elementLeft, x - 1, y);
+                            ed1.UpdateElementProperties(*elementLeft, x - 1, y);
                             UpdateChunkDirtyRect(x, y, chunk);
                             continue;
                         }
                     }
 
-                    if (elementTop != nullptr) {
-                        it =
-                            ElementData::s_ReactionTable[currElement.m_ID].find(
-                                elementTop->m_ID);
-                        end = ElementData::s_ReactionTable[currElement.m_ID]
-                                  .end();
-                        if (it != end && GetRandom() < it->second.probability) {
-                            currElement.m_ID = it->second.cell0ID;
+                    if (elementTop != std::nullopt) {
+                        const ReactionResult &reaction =
+                            ElementData::GetReaction(currElement.m_ID,
+                                                     elementTop->m_ID);
+                        if (reaction.probability > 0 &&
+                            GetRandom() < reaction.probability) {
+                            currElement.m_ID = reaction.cell0ID;
                             ElementProperties &ed0 =
                                 ElementData::GetElementProperties(
-                                    it->second.cell0ID);
+                                    reaction.cell0ID);
                             ed0.UpdateElementProperties(currElement, x, y);
-                            if (ed0.cell_type == ElementType::solid ||
-                                ed0.cell_type == ElementType::movableSolid) {
-                                chunk->m_MeshChanged = true;
+                            if (ElementData::IsColliderSolid(
+                                    reaction.cell0ID)) {
+                                chunk->MarkMeshChanged();
                             }
 
-                            elementTop->m_ID = it->second.cell1ID;
+                            elementTop->m_ID = reaction.cell1ID;
                             ElementProperties &ed1 =
                                 ElementData::GetElementProperties(
-                                    it->second.cell1ID);
-                            if (ed1.cell_type == ElementType::solid ||
-                                ed1.cell_type == ElementType::movableSolid) {
-                                topChunk->m_MeshChanged = true;
+                                    reaction.cell1ID);
+                            if (ElementData::IsColliderSolid(
+                                    reaction.cell1ID)) {
+                                topChunk->MarkMeshChanged();
                             }
-                            ed1.UpdateElementProperties(elementTop, x - 1, y);
+                            ed1.UpdateElementProperties(*elementTop, x - 1, y);
                             UpdateChunkDirtyRect(x, y, chunk);
                             continue;
                         }
                     }
 
-                    if (elementRight != nullptr) {
-                        it =
-                            ElementData::s_ReactionTable[currElement.m_ID].find(
-                                elementRight->m_ID);
-                        end = ElementData::s_ReactionTable[currElement.m_ID]
-                                  .end();
-                        if (it != end && GetRandom() < it->second.probability) {
-                            currElement.m_ID = it->second.cell0ID;
+                    if (elementRight != std::nullopt) {
+                        const ReactionResult &reaction =
+                            ElementData::GetReaction(currElement.m_ID,
+                                                     elementRight->m_ID);
+                        if (reaction.probability > 0 &&
+                            GetRandom() < reaction.probability) {
+                            currElement.m_ID = reaction.cell0ID;
                             ElementProperties &ed0 =
                                 ElementData::GetElementProperties(
-                                    it->second.cell0ID);
+                                    reaction.cell0ID);
                             ed0.UpdateElementProperties(currElement, x, y);
-                            if (ed0.cell_type == ElementType::solid ||
-                                ed0.cell_type == ElementType::movableSolid) {
-                                chunk->m_MeshChanged = true;
+                            if (ElementData::IsColliderSolid(
+                                    reaction.cell0ID)) {
+                                chunk->MarkMeshChanged();
                             }
 
-                            elementRight->m_ID = it->second.cell1ID;
+                            elementRight->m_ID = reaction.cell1ID;
                             ElementProperties &ed1 =
                                 ElementData::GetElementProperties(
-                                    it->second.cell1ID);
-                            if (ed1.cell_type == ElementType::solid ||
-                                ed1.cell_type == ElementType::movableSolid) {
-                                rightChunk->m_MeshChanged = true;
+                                    reaction.cell1ID);
+                            if (ElementData::IsColliderSolid(
+                                    reaction.cell1ID)) {
+                                rightChunk->MarkMeshChanged();
                             }
-                            ed1.UpdateElementProperties(elementRight, x - 1, y);
+                            ed1.UpdateElementProperties(*elementRight, x - 1,
+                                                        y);
                             UpdateChunkDirtyRect(x, y, chunk);
                             continue;
                         }
                     }
 
-                    if (elementBottom != nullptr) {
-                        it =
-                            ElementData::s_ReactionTable[currElement.m_ID].find(
-                                elementBottom->m_ID);
-                        end = ElementData::s_ReactionTable[currElement.m_ID]
-                                  .end();
-                        if (it != end && GetRandom() < it->second.probability) {
-                            currElement.m_ID = it->second.cell0ID;
+                    if (elementBottom != std::nullopt) {
+                        const ReactionResult &reaction =
+                            ElementData::GetReaction(currElement.m_ID,
+                                                     elementBottom->m_ID);
+                        if (reaction.probability > 0 &&
+                            GetRandom() < reaction.probability) {
+                            currElement.m_ID = reaction.cell0ID;
                             ElementProperties &ed0 =
                                 ElementData::GetElementProperties(
-                                    it->second.cell0ID);
+                                    reaction.cell0ID);
                             ed0.UpdateElementProperties(currElement, x, y);
-                            if (ed0.cell_type == ElementType::solid ||
-                                ed0.cell_type == ElementType::movableSolid) {
-                                chunk->m_MeshChanged = true;
+                            if (ElementData::IsColliderSolid(
+                                    reaction.cell0ID)) {
+                                chunk->MarkMeshChanged();
                             }
 
-                            elementBottom->m_ID = it->second.cell1ID;
+                            elementBottom->m_ID = reaction.cell1ID;
                             ElementProperties &ed1 =
                                 ElementData::GetElementProperties(
-                                    it->second.cell1ID);
-                            if (ed1.cell_type == ElementType::solid ||
-                                ed1.cell_type == ElementType::movableSolid) {
-                                bottomChunk->m_MeshChanged = true;
+                                    reaction.cell1ID);
+                            if (ElementData::IsColliderSolid(
+                                    reaction.cell1ID)) {
+                                bottomChunk->MarkMeshChanged();
                             }
-                            ed1.UpdateElementProperties(elementBottom, x - 1,
+                            ed1.UpdateElementProperties(*elementBottom, x - 1,
                                                         y);
                             UpdateChunkDirtyRect(x, y, chunk);
                             continue;
@@ -968,17 +1263,15 @@ void World::UpdateChunk(Chunk *chunk) {
                 if (currElement.m_Temperature >=
                     currElementData.melting_point) {
                     // melt
-                    if (currElementData.melted != "") {
-                        int newID =
-                            ElementData::s_ElementNameToID[currElementData
-                                                               .melted];
+                    if (currElementData.melted_id !=
+                        SimElementInfo::NoElement) {
+                        int newID = currElementData.melted_id;
                         int temp = currElement.m_Temperature;
                         ElementProperties &newData =
                             ElementData::GetElementProperties(newID);
                         newData.UpdateElementProperties(currElement, x, y);
-                        if (newData.cell_type == ElementType::solid ||
-                            newData.cell_type == ElementType::movableSolid) {
-                            chunk->m_MeshChanged = true;
+                        if (ElementData::IsColliderSolid(newID)) {
+                            chunk->MarkMeshChanged();
                         }
                         currElement.m_Temperature = temp;
                         currElement.m_ID = newID;
@@ -990,18 +1283,16 @@ void World::UpdateChunk(Chunk *chunk) {
                 if (currElement.m_Temperature <=
                     currElementData.freezing_point) {
                     // freeze
-                    if (currElementData.frozen != "") {
-                        int newID =
-                            ElementData::s_ElementNameToID[currElementData
-                                                               .frozen];
+                    if (currElementData.frozen_id !=
+                        SimElementInfo::NoElement) {
+                        int newID = currElementData.frozen_id;
                         int temp = currElement.m_Temperature;
 
                         ElementProperties &newData =
                             ElementData::GetElementProperties(newID);
                         newData.UpdateElementProperties(currElement, x, y);
-                        if (newData.cell_type == ElementType::solid ||
-                            newData.cell_type == ElementType::movableSolid) {
-                            chunk->m_MeshChanged = true;
+                        if (ElementData::IsColliderSolid(newID)) {
+                            chunk->MarkMeshChanged();
                         }
 
                         currElement.m_Temperature = temp;
@@ -1016,7 +1307,7 @@ void World::UpdateChunk(Chunk *chunk) {
                     int minConductivity = 0;
                     float diff = 0;
 
-                    if (elementLeft != nullptr && elementLeft->m_ID != 0) {
+                    if (elementLeft != std::nullopt && elementLeft->m_ID != 0) {
                         minConductivity =
                             std::min(currElementData.conductivity,
                                      elementLeftData->conductivity);
@@ -1032,7 +1323,7 @@ void World::UpdateChunk(Chunk *chunk) {
                         }
                     }
 
-                    if (elementTop != nullptr && elementTop->m_ID != 0) {
+                    if (elementTop != std::nullopt && elementTop->m_ID != 0) {
                         minConductivity =
                             std::min(currElementData.conductivity,
                                      elementTopData->conductivity);
@@ -1048,7 +1339,8 @@ void World::UpdateChunk(Chunk *chunk) {
                         }
                     }
 
-                    if (elementRight != nullptr && elementRight->m_ID != 0) {
+                    if (elementRight != std::nullopt &&
+                        elementRight->m_ID != 0) {
                         minConductivity =
                             std::min(currElementData.conductivity,
                                      elementRightData->conductivity);
@@ -1064,7 +1356,8 @@ void World::UpdateChunk(Chunk *chunk) {
                         }
                     }
 
-                    if (elementBottom != nullptr && elementBottom->m_ID != 0) {
+                    if (elementBottom != std::nullopt &&
+                        elementBottom->m_ID != 0) {
                         minConductivity =
                             std::min(currElementData.conductivity,
                                      elementBottomData->conductivity);
@@ -1099,35 +1392,35 @@ void World::UpdateChunk(Chunk *chunk) {
                         if (currElementData.spread_ignition &&
                             GetRandom() <
                                 currElementData.spread_ignition_chance) {
-                            if (elementLeft != nullptr &&
+                            if (elementLeft != std::nullopt &&
                                 elementLeftData->flammable)
                                 elementLeft->m_Ignited = true;
-                            if (elementTop != nullptr &&
+                            if (elementTop != std::nullopt &&
                                 elementTopData->flammable)
                                 elementTop->m_Ignited = true;
-                            if (elementRight != nullptr &&
+                            if (elementRight != std::nullopt &&
                                 elementRightData->flammable)
                                 elementRight->m_Ignited = true;
-                            if (elementBottom != nullptr &&
+                            if (elementBottom != std::nullopt &&
                                 elementBottomData->flammable)
                                 elementBottom->m_Ignited = true;
                         }
 
                         // check for open air to burn
-                        int fireID = ElementData::s_ElementNameToID["fire"];
+                        int fireID = ElementData::s_FireID;
                         ElementProperties &fireElementData =
                             ElementData::GetElementProperties(fireID);
                         if (currElement.m_ID != fireID) //&& GetRandom() < 5
                         {
 
                             int healthDiff = currElement.m_Health;
-                            if (elementLeft != nullptr &&
+                            if (elementLeft != std::nullopt &&
                                 (elementLeftData->cell_type ==
                                      ElementType::gas ||
                                  elementLeftData->cell_type ==
                                      ElementType::fire)) {
                                 fireElementData.UpdateElementProperties(
-                                    elementLeft, x - 1, y);
+                                    *elementLeft, x - 1, y);
                                 elementLeft->m_ID = fireID;
                                 elementLeft->m_Temperature =
                                     currElementData.fire_temperature;
@@ -1145,13 +1438,13 @@ void World::UpdateChunk(Chunk *chunk) {
                                             .fire_temperature_increase;
                             }
 
-                            if (elementTop != nullptr &&
+                            if (elementTop != std::nullopt &&
                                 (elementTopData->cell_type ==
                                      ElementType::gas ||
                                  elementTopData->cell_type ==
                                      ElementType::fire)) {
                                 fireElementData.UpdateElementProperties(
-                                    elementTop, x, y + 1);
+                                    *elementTop, x, y + 1);
                                 elementTop->m_ID = fireID;
                                 elementTop->m_Temperature =
                                     currElementData.fire_temperature;
@@ -1169,13 +1462,13 @@ void World::UpdateChunk(Chunk *chunk) {
                                             .fire_temperature_increase;
                             }
 
-                            if (elementRight != nullptr &&
+                            if (elementRight != std::nullopt &&
                                 (elementRightData->cell_type ==
                                      ElementType::gas ||
                                  elementRightData->cell_type ==
                                      ElementType::fire)) {
                                 fireElementData.UpdateElementProperties(
-                                    elementRight, x + 1, y);
+                                    *elementRight, x + 1, y);
                                 elementRight->m_ID = fireID;
                                 elementRight->m_Temperature =
                                     currElementData.fire_temperature;
@@ -1193,13 +1486,13 @@ void World::UpdateChunk(Chunk *chunk) {
                                             .fire_temperature_increase;
                             }
 
-                            if (elementBottom != nullptr &&
+                            if (elementBottom != std::nullopt &&
                                 (elementBottomData->cell_type ==
                                      ElementType::gas ||
                                  elementBottomData->cell_type ==
                                      ElementType::fire)) {
                                 fireElementData.UpdateElementProperties(
-                                    elementBottom, x, y - 1);
+                                    *elementBottom, x, y - 1);
                                 elementBottom->m_ID = fireID;
                                 elementBottom->m_Temperature =
                                     currElementData.fire_temperature;
@@ -1227,15 +1520,11 @@ void World::UpdateChunk(Chunk *chunk) {
                         if (currElement.m_Health <= 0) {
                             // burnt
                             int temp = currElement.m_Temperature;
-                            uint32_t burntID =
-                                ElementData::s_ElementNameToID[currElementData
-                                                                   .burnt];
+                            uint32_t burntID = currElementData.burnt_id;
                             ElementProperties &burntData =
                                 ElementData::GetElementProperties(burntID);
-                            if (burntData.cell_type == ElementType::solid ||
-                                burntData.cell_type ==
-                                    ElementType::movableSolid) {
-                                chunk->m_MeshChanged = true;
+                            if (ElementData::IsColliderSolid(burntID)) {
+                                chunk->MarkMeshChanged();
                             }
                             burntData.UpdateElementProperties(currElement, x,
                                                               y);
@@ -1291,7 +1580,7 @@ void World::UpdateChunk(Chunk *chunk) {
                         continue;
 
                     // check below, and move
-                    if (elementBottom != nullptr &&
+                    if (elementBottom != std::nullopt &&
                         elementBottomData->cell_type != ElementType::solid &&
                         elementBottomData->cell_type !=
                             ElementType::movableSolid &&
@@ -1304,9 +1593,9 @@ void World::UpdateChunk(Chunk *chunk) {
                             x, (y + (CHUNKSIZE - 1)) % CHUNKSIZE, temp);
                         //*elementBottom = temp;
                         UpdateChunkDirtyRect(x, y, chunk);
-                        if (elementLeft != nullptr)
+                        if (elementLeft != std::nullopt)
                             elementLeft->m_Sliding = true;
-                        if (elementRight != nullptr)
+                        if (elementRight != std::nullopt)
                             elementRight->m_Sliding = true;
                         continue;
                     }
@@ -1329,7 +1618,7 @@ void World::UpdateChunk(Chunk *chunk) {
 
                     // try moving to the side
                     if (currElement.m_Horizontal > 0) {
-                        if (elementRight != nullptr &&
+                        if (elementRight != std::nullopt &&
                             elementRightData->cell_type != ElementType::solid &&
                             elementRightData->cell_type !=
                                 ElementType::movableSolid &&
@@ -1347,7 +1636,7 @@ void World::UpdateChunk(Chunk *chunk) {
                             continue;
                         }
                     } else {
-                        if (elementLeft != nullptr &&
+                        if (elementLeft != std::nullopt &&
                             elementLeftData->cell_type != ElementType::solid &&
                             elementLeftData->cell_type !=
                                 ElementType::movableSolid &&
@@ -1369,13 +1658,13 @@ void World::UpdateChunk(Chunk *chunk) {
                     break;
                 case ElementType::liquid:
                     // check below, and move
-                    if (elementBottom != nullptr &&
+                    if (elementBottom != std::nullopt &&
                         elementBottomData->cell_type != ElementType::solid &&
                         elementBottomData->cell_type !=
                             ElementType::movableSolid &&
                         elementBottomData->density < currElementData.density) {
                         Element temp = currElement;
-                        chunk->m_Elements[x + y * CHUNKSIZE] = *elementBottom;
+                        chunk->GetElement(x, y) = *elementBottom;
                         *elementBottom = temp;
                         UpdateChunkDirtyRect(x, y, chunk);
                         continue;
@@ -1389,56 +1678,54 @@ void World::UpdateChunk(Chunk *chunk) {
 
                     if (r == 1) {
                         // check right, and move
-                        if (elementRight != nullptr &&
+                        if (elementRight != std::nullopt &&
                             elementRightData->cell_type != ElementType::solid &&
                             elementRightData->cell_type !=
                                 ElementType::movableSolid &&
                             elementRightData->density <
                                 currElementData.density) {
                             Element temp = currElement;
-                            chunk->m_Elements[x + y * CHUNKSIZE] =
-                                *elementRight;
+                            chunk->GetElement(x, y) = *elementRight;
                             *elementRight = temp;
                             UpdateChunkDirtyRect(x, y, chunk);
                             continue;
                         }
                         // check left, and move
-                        if (elementLeft != nullptr &&
+                        if (elementLeft != std::nullopt &&
                             elementLeftData->cell_type != ElementType::solid &&
                             elementLeftData->cell_type !=
                                 ElementType::movableSolid &&
                             elementLeftData->density <
                                 currElementData.density) {
                             Element temp = currElement;
-                            chunk->m_Elements[x + y * CHUNKSIZE] = *elementLeft;
+                            chunk->GetElement(x, y) = *elementLeft;
                             *elementLeft = temp;
                             UpdateChunkDirtyRect(x, y, chunk);
                             continue;
                         }
                     } else {
                         // check left, and move
-                        if (elementLeft != nullptr &&
+                        if (elementLeft != std::nullopt &&
                             elementLeftData->cell_type != ElementType::solid &&
                             elementLeftData->cell_type !=
                                 ElementType::movableSolid &&
                             elementLeftData->density <
                                 currElementData.density) {
                             Element temp = currElement;
-                            chunk->m_Elements[x + y * CHUNKSIZE] = *elementLeft;
+                            chunk->GetElement(x, y) = *elementLeft;
                             *elementLeft = temp;
                             UpdateChunkDirtyRect(x, y, chunk);
                             continue;
                         }
                         // check right, and move
-                        if (elementRight != nullptr &&
+                        if (elementRight != std::nullopt &&
                             elementRightData->cell_type != ElementType::solid &&
                             elementRightData->cell_type !=
                                 ElementType::movableSolid &&
                             elementRightData->density <
                                 currElementData.density) {
                             Element temp = currElement;
-                            chunk->m_Elements[x + y * CHUNKSIZE] =
-                                *elementRight;
+                            chunk->GetElement(x, y) = *elementRight;
                             *elementRight = temp;
                             UpdateChunkDirtyRect(x, y, chunk);
                             continue;
@@ -1456,14 +1743,14 @@ void World::UpdateChunk(Chunk *chunk) {
                     r = (GetRandom() % 3) - 1; //-1 0 1
                     if (r == 0) {
                         // check above, and move
-                        if (elementTop != nullptr &&
+                        if (elementTop != std::nullopt &&
                             (elementTopData->cell_type == ElementType::gas ||
                              elementTopData->cell_type ==
                                  ElementType::liquid) &&
                             elementTopData->density < currElementData.density) {
                             currElement.m_Sliding = true;
                             Element temp = currElement;
-                            chunk->m_Elements[x + y * CHUNKSIZE] = *elementTop;
+                            chunk->GetElement(x, y) = *elementTop;
                             *elementTop = temp;
                             UpdateChunkDirtyRect(x, y, chunk);
                             continue;
@@ -1473,7 +1760,7 @@ void World::UpdateChunk(Chunk *chunk) {
                     // try left/right
                     if (r > 0) {
                         // check right, and move
-                        if (elementRight != nullptr &&
+                        if (elementRight != std::nullopt &&
                             (elementRightData->cell_type == ElementType::gas ||
                              elementRightData->cell_type ==
                                  ElementType::liquid) &&
@@ -1481,14 +1768,13 @@ void World::UpdateChunk(Chunk *chunk) {
                                 currElementData.density) {
                             currElement.m_Sliding = true;
                             Element temp = currElement;
-                            chunk->m_Elements[x + y * CHUNKSIZE] =
-                                *elementRight;
+                            chunk->GetElement(x, y) = *elementRight;
                             *elementRight = temp;
                             UpdateChunkDirtyRect(x, y, chunk);
                             continue;
                         }
                         // check left and move
-                        if (elementLeft != nullptr &&
+                        if (elementLeft != std::nullopt &&
                             (elementLeftData->cell_type == ElementType::gas ||
                              elementLeftData->cell_type ==
                                  ElementType::liquid) &&
@@ -1496,7 +1782,7 @@ void World::UpdateChunk(Chunk *chunk) {
                                 currElementData.density) {
                             currElement.m_Sliding = true;
                             Element temp = currElement;
-                            chunk->m_Elements[x + y * CHUNKSIZE] = *elementLeft;
+                            chunk->GetElement(x, y) = *elementLeft;
                             *elementLeft = temp;
                             UpdateChunkDirtyRect(x, y, chunk);
                             continue;
@@ -1504,7 +1790,7 @@ void World::UpdateChunk(Chunk *chunk) {
 
                     } else {
                         // check left and move
-                        if (elementLeft != nullptr &&
+                        if (elementLeft != std::nullopt &&
                             (elementLeftData->cell_type == ElementType::gas ||
                              elementLeftData->cell_type ==
                                  ElementType::liquid) &&
@@ -1512,13 +1798,13 @@ void World::UpdateChunk(Chunk *chunk) {
                                 currElementData.density) {
                             currElement.m_Sliding = true;
                             Element temp = currElement;
-                            chunk->m_Elements[x + y * CHUNKSIZE] = *elementLeft;
+                            chunk->GetElement(x, y) = *elementLeft;
                             *elementLeft = temp;
                             UpdateChunkDirtyRect(x, y, chunk);
                             continue;
                         }
                         // check right, and move
-                        if (elementRight != nullptr &&
+                        if (elementRight != std::nullopt &&
                             (elementRightData->cell_type == ElementType::gas ||
                              elementRightData->cell_type ==
                                  ElementType::liquid) &&
@@ -1526,8 +1812,7 @@ void World::UpdateChunk(Chunk *chunk) {
                                 currElementData.density) {
                             currElement.m_Sliding = true;
                             Element temp = currElement;
-                            chunk->m_Elements[x + y * CHUNKSIZE] =
-                                *elementRight;
+                            chunk->GetElement(x, y) = *elementRight;
                             *elementRight = temp;
                             UpdateChunkDirtyRect(x, y, chunk);
                             continue;
@@ -1578,18 +1863,18 @@ void World::UpdateChunk(Chunk *chunk) {
                     if (r > 20 && r < 80) //~60% to go up
                     {
                         // check above, and move
-                        if (elementTop != nullptr &&
+                        if (elementTop != std::nullopt &&
                             elementTopData->cell_type == ElementType::gas &&
                             (elementTopData->density >
                                  currElementData.density ||
                              elementTop->m_ID == 0)) {
                             currElement.m_Sliding = true;
                             Element temp = currElement;
-                            chunk->m_Elements[x + y * CHUNKSIZE] = *elementTop;
+                            chunk->GetElement(x, y) = *elementTop;
                             *elementTop = temp;
                             UpdateChunkDirtyRect(x, y, chunk);
                             continue;
-                        } else if (elementTop != nullptr &&
+                        } else if (elementTop != std::nullopt &&
                                    elementTopData->cell_type ==
                                        ElementType::fire) {
                             // moving to fire, so combine temp and leave air
@@ -1603,16 +1888,15 @@ void World::UpdateChunk(Chunk *chunk) {
                         }
                     } else if (r > 50) // left / right
                     {
-                        if (elementRight != nullptr &&
+                        if (elementRight != std::nullopt &&
                             elementRightData->cell_type == ElementType::gas) {
                             currElement.m_Sliding = true;
                             Element temp = currElement;
-                            chunk->m_Elements[x + y * CHUNKSIZE] =
-                                *elementRight;
+                            chunk->GetElement(x, y) = *elementRight;
                             *elementRight = temp;
                             UpdateChunkDirtyRect(x, y, chunk);
                             continue;
-                        } else if (elementRight != nullptr &&
+                        } else if (elementRight != std::nullopt &&
                                    elementRightData->cell_type ==
                                        ElementType::fire) {
                             // moving to fire, so combine temp and leave air
@@ -1623,15 +1907,15 @@ void World::UpdateChunk(Chunk *chunk) {
                             ElementData::GetElementProperties(0)
                                 .UpdateElementProperties(currElement, x, y);
                         }
-                        if (elementLeft != nullptr &&
+                        if (elementLeft != std::nullopt &&
                             elementLeftData->cell_type == ElementType::gas) {
                             currElement.m_Sliding = true;
                             Element temp = currElement;
-                            chunk->m_Elements[x + y * CHUNKSIZE] = *elementLeft;
+                            chunk->GetElement(x, y) = *elementLeft;
                             *elementLeft = temp;
                             UpdateChunkDirtyRect(x, y, chunk);
                             continue;
-                        } else if (elementLeft != nullptr &&
+                        } else if (elementLeft != std::nullopt &&
                                    elementLeftData->cell_type ==
                                        ElementType::fire) {
                             // moving to fire, so combine temp and leave air
@@ -1643,15 +1927,15 @@ void World::UpdateChunk(Chunk *chunk) {
                                 .UpdateElementProperties(currElement, x, y);
                         }
                     } else {
-                        if (elementLeft != nullptr &&
+                        if (elementLeft != std::nullopt &&
                             elementLeftData->cell_type == ElementType::gas) {
                             currElement.m_Sliding = true;
                             Element temp = currElement;
-                            chunk->m_Elements[x + y * CHUNKSIZE] = *elementLeft;
+                            chunk->GetElement(x, y) = *elementLeft;
                             *elementLeft = temp;
                             UpdateChunkDirtyRect(x, y, chunk);
                             continue;
-                        } else if (elementLeft != nullptr &&
+                        } else if (elementLeft != std::nullopt &&
                                    elementLeftData->cell_type ==
                                        ElementType::fire) {
                             // moving to fire, so combine temp and leave air
@@ -1662,16 +1946,15 @@ void World::UpdateChunk(Chunk *chunk) {
                             ElementData::GetElementProperties(0)
                                 .UpdateElementProperties(currElement, x, y);
                         }
-                        if (elementRight != nullptr &&
+                        if (elementRight != std::nullopt &&
                             elementRightData->cell_type == ElementType::gas) {
                             currElement.m_Sliding = true;
                             Element temp = currElement;
-                            chunk->m_Elements[x + y * CHUNKSIZE] =
-                                *elementRight;
+                            chunk->GetElement(x, y) = *elementRight;
                             *elementRight = temp;
                             UpdateChunkDirtyRect(x, y, chunk);
                             continue;
-                        } else if (elementRight != nullptr &&
+                        } else if (elementRight != std::nullopt &&
                                    elementRightData->cell_type ==
                                        ElementType::fire) {
                             // moving to fire, so combine temp and leave air
@@ -1695,9 +1978,13 @@ void World::UpdateChunk(Chunk *chunk) {
 /// dirty rect to neighboring chunks if it is touching the edge
 ///
 /// The x and y are in index coordinates, not world.
+///
+/// Chunks updated in the same phase can share a neighbor, so the neighbors
+/// are locked while their dirty rect grows.
 /// </summary>
 void World::UpdateChunkDirtyRect(int x, int y, Chunk *chunk) {
     chunk->UpdateDirtyRect(x, y);
+    WakeChunk(chunk);
 
     // there are only 8 cases, so i will use a switch statement with bits?
     int result = 0;
@@ -1719,99 +2006,115 @@ void World::UpdateChunkDirtyRect(int x, int y, Chunk *chunk) {
 
     switch (result) {
     case 8: // top
-        ChunkToUpdate = GetChunk(chunk->m_ChunkPos + glm::ivec2(0, 1));
+        ChunkToUpdate = chunk->GetNeighbor(0, 1);
         if (ChunkToUpdate != nullptr) {
-            ChunkToUpdate->UpdateDirtyRect(x, -1);
+            ChunkToUpdate->UpdateDirtyRectLocked(x, -1);
+            WakeChunk(ChunkToUpdate);
         }
         break;
     case 12: // top right
         // top
-        ChunkToUpdate = GetChunk(chunk->m_ChunkPos + glm::ivec2(0, 1));
+        ChunkToUpdate = chunk->GetNeighbor(0, 1);
         if (ChunkToUpdate != nullptr) {
-            ChunkToUpdate->UpdateDirtyRect(x, -1);
+            ChunkToUpdate->UpdateDirtyRectLocked(x, -1);
+            WakeChunk(ChunkToUpdate);
         }
         // top right
-        ChunkToUpdate = GetChunk(chunk->m_ChunkPos + glm::ivec2(1, 1));
+        ChunkToUpdate = chunk->GetNeighbor(1, 1);
         if (ChunkToUpdate != nullptr) {
-            ChunkToUpdate->UpdateDirtyRect(-1, -1);
+            ChunkToUpdate->UpdateDirtyRectLocked(-1, -1);
+            WakeChunk(ChunkToUpdate);
         }
         // right
-        ChunkToUpdate = GetChunk(chunk->m_ChunkPos + glm::ivec2(1, 0));
+        ChunkToUpdate = chunk->GetNeighbor(1, 0);
         if (ChunkToUpdate != nullptr) {
-            ChunkToUpdate->UpdateDirtyRect(-1, y);
+            ChunkToUpdate->UpdateDirtyRectLocked(-1, y);
+            WakeChunk(ChunkToUpdate);
         }
         break;
     case 4: // right
         // right
-        ChunkToUpdate = GetChunk(chunk->m_ChunkPos + glm::ivec2(1, 0));
+        ChunkToUpdate = chunk->GetNeighbor(1, 0);
         if (ChunkToUpdate != nullptr) {
-            ChunkToUpdate->UpdateDirtyRect(-1, y);
+            ChunkToUpdate->UpdateDirtyRectLocked(-1, y);
+            WakeChunk(ChunkToUpdate);
         }
         break;
     case 6: // right bottom
         // right
-        ChunkToUpdate = GetChunk(chunk->m_ChunkPos + glm::ivec2(1, 0));
+        ChunkToUpdate = chunk->GetNeighbor(1, 0);
         if (ChunkToUpdate != nullptr) {
-            ChunkToUpdate->UpdateDirtyRect(-1, y);
+            ChunkToUpdate->UpdateDirtyRectLocked(-1, y);
+            WakeChunk(ChunkToUpdate);
         }
         // bottom right
-        ChunkToUpdate = GetChunk(chunk->m_ChunkPos + glm::ivec2(1, -1));
+        ChunkToUpdate = chunk->GetNeighbor(1, -1);
         if (ChunkToUpdate != nullptr) {
-            ChunkToUpdate->UpdateDirtyRect(-1, CHUNKSIZE - 1);
+            ChunkToUpdate->UpdateDirtyRectLocked(-1, CHUNKSIZE - 1);
+            WakeChunk(ChunkToUpdate);
         }
         // bottom
-        ChunkToUpdate = GetChunk(chunk->m_ChunkPos + glm::ivec2(0, -1));
+        ChunkToUpdate = chunk->GetNeighbor(0, -1);
         if (ChunkToUpdate != nullptr) {
-            ChunkToUpdate->UpdateDirtyRect(x, CHUNKSIZE - 1);
+            ChunkToUpdate->UpdateDirtyRectLocked(x, CHUNKSIZE - 1);
+            WakeChunk(ChunkToUpdate);
         }
         break;
     case 2: // bottom
         // bottom
-        ChunkToUpdate = GetChunk(chunk->m_ChunkPos + glm::ivec2(0, -1));
+        ChunkToUpdate = chunk->GetNeighbor(0, -1);
         if (ChunkToUpdate != nullptr) {
-            ChunkToUpdate->UpdateDirtyRect(x, CHUNKSIZE - 1);
+            ChunkToUpdate->UpdateDirtyRectLocked(x, CHUNKSIZE - 1);
+            WakeChunk(ChunkToUpdate);
         }
         break;
     case 3: // bottom left
 
         // left
-        ChunkToUpdate = GetChunk(chunk->m_ChunkPos + glm::ivec2(-1, 0));
+        ChunkToUpdate = chunk->GetNeighbor(-1, 0);
         if (ChunkToUpdate != nullptr) {
-            ChunkToUpdate->UpdateDirtyRect(CHUNKSIZE - 1, y);
+            ChunkToUpdate->UpdateDirtyRectLocked(CHUNKSIZE - 1, y);
+            WakeChunk(ChunkToUpdate);
         }
         // bottom left
-        ChunkToUpdate = GetChunk(chunk->m_ChunkPos + glm::ivec2(-1, -1));
+        ChunkToUpdate = chunk->GetNeighbor(-1, -1);
         if (ChunkToUpdate != nullptr) {
-            ChunkToUpdate->UpdateDirtyRect(CHUNKSIZE - 1, CHUNKSIZE - 1);
+            ChunkToUpdate->UpdateDirtyRectLocked(CHUNKSIZE - 1, CHUNKSIZE - 1);
+            WakeChunk(ChunkToUpdate);
         }
         // bottom
-        ChunkToUpdate = GetChunk(chunk->m_ChunkPos + glm::ivec2(0, -1));
+        ChunkToUpdate = chunk->GetNeighbor(0, -1);
         if (ChunkToUpdate != nullptr) {
-            ChunkToUpdate->UpdateDirtyRect(x, CHUNKSIZE - 1);
+            ChunkToUpdate->UpdateDirtyRectLocked(x, CHUNKSIZE - 1);
+            WakeChunk(ChunkToUpdate);
         }
         break;
     case 1: // left
         // left
-        ChunkToUpdate = GetChunk(chunk->m_ChunkPos + glm::ivec2(-1, 0));
+        ChunkToUpdate = chunk->GetNeighbor(-1, 0);
         if (ChunkToUpdate != nullptr) {
-            ChunkToUpdate->UpdateDirtyRect(CHUNKSIZE - 1, y);
+            ChunkToUpdate->UpdateDirtyRectLocked(CHUNKSIZE - 1, y);
+            WakeChunk(ChunkToUpdate);
         }
         break;
     case 9: // top left
         // left
-        ChunkToUpdate = GetChunk(chunk->m_ChunkPos + glm::ivec2(-1, 0));
+        ChunkToUpdate = chunk->GetNeighbor(-1, 0);
         if (ChunkToUpdate != nullptr) {
-            ChunkToUpdate->UpdateDirtyRect(CHUNKSIZE - 1, y);
+            ChunkToUpdate->UpdateDirtyRectLocked(CHUNKSIZE - 1, y);
+            WakeChunk(ChunkToUpdate);
         }
         // top left
-        ChunkToUpdate = GetChunk(chunk->m_ChunkPos + glm::ivec2(-1, 1));
+        ChunkToUpdate = chunk->GetNeighbor(-1, 1);
         if (ChunkToUpdate != nullptr) {
-            ChunkToUpdate->UpdateDirtyRect(CHUNKSIZE - 1, -1);
+            ChunkToUpdate->UpdateDirtyRectLocked(CHUNKSIZE - 1, -1);
+            WakeChunk(ChunkToUpdate);
         }
         // top
-        ChunkToUpdate = GetChunk(chunk->m_ChunkPos + glm::ivec2(0, 1));
+        ChunkToUpdate = chunk->GetNeighbor(0, 1);
         if (ChunkToUpdate != nullptr) {
-            ChunkToUpdate->UpdateDirtyRect(x, -1);
+            ChunkToUpdate->UpdateDirtyRectLocked(x, -1);
+            WakeChunk(ChunkToUpdate);
         }
         break;
     }
@@ -1842,8 +2145,8 @@ void World::UpdateParticles() {
         // begin with seeing if the particle is starting in a collision. this
         // usually would only happen if it just landed with another particle, or
         // if it was spawned inside a solid moving object.
-        Element &element = ForceGetElement(particle.m_Position);
-        ElementProperties &ed = ElementData::GetElementProperties(element.m_ID);
+        ElementRef element = ForceGetElement(particle.m_Position);
+        const SimElementInfo &ed = ElementData::GetSimInfo(element.m_ID);
         // if we are in something rigid, or we collide with it, we need to slow
         // our velocity until we "die"
         bool startedInCollision = false;
@@ -1860,15 +2163,14 @@ void World::UpdateParticles() {
             // If the particle is moving slowly, it has "died"
             // keep climbing up the same material until it's not the same
             // material.
-            Element *e = &ForceGetElement(particle.m_Position);
-            while (e->m_ID == particle.m_Element.m_ID || e->m_Rigid) {
+            Element e = ForceGetElement(particle.m_Position);
+            while (e.m_ID == particle.m_Element.m_ID || e.m_Rigid) {
                 particle.m_Position.y += 1;
-                e = &ForceGetElement(particle.m_Position);
+                e = ForceGetElement(particle.m_Position);
             }
             // e is now not of the same element, and not a rigid body. So see if
             // it collides, and if not, set the particle to that position.
-            ElementProperties &deadED =
-                ElementData::GetElementProperties(e->m_ID);
+            const SimElementInfo &deadED = ElementData::GetSimInfo(e.m_ID);
             if ((static_cast<ElementTypeType>(deadED.cell_type) &
                  particle.m_CollisionFlags) >= 1) {
                 // Collision detected
@@ -1903,9 +2205,8 @@ void World::UpdateParticles() {
         int index = 1;
         // loop over the path and see when we collide
         for (auto it = path.begin() + 1; it != path.end(); it++) {
-            Element &element = ForceGetElement(*it);
-            ElementProperties &ed =
-                ElementData::GetElementProperties(element.m_ID);
+            ElementRef element = ForceGetElement(*it);
+            const SimElementInfo &ed = ElementData::GetSimInfo(element.m_ID);
             // Check collision
             if (element.m_Rigid ||
                 ((static_cast<int>(ed.cell_type) &
@@ -1962,9 +2263,17 @@ void World::RenderParticles() {
 /// </summary>
 void World::Clear() {
     for (auto &pair : m_Chunks) {
-        delete pair.second;
+        ReleaseChunk(pair.second);
     }
     m_Chunks.clear();
+    m_ChunkOrder.clear();
+    m_ActiveChunks.clear();
+    m_ChunkStorage.Clear();
+    DropPrefetchedChunks();
+    // pooled bodies go with the physics world, before their ids can be reused
+    for (Chunk *chunk : m_ChunkPool) {
+        chunk->DestroyPhysicsBody();
+    }
 
     Physics2D::ClearWorld();
     Physics2D::GetWorld();
@@ -2097,12 +2406,13 @@ void World::SeedRandom(int xPos, int yPos) {
                         (((yPos * 986124) * m_SimulationTick) >> 2);
 
     // PX_TRACE("Seeded rand with: {0}", seed);
-    m_RandomEngine.seed(seed);
+    s_RandomEngine.seed(seed);
+    s_Rand.reset();
     // std::srand(seed);
 }
 
 int World::GetRandom() {
-    int result = m_Rand(m_RandomEngine);
+    int result = s_Rand(s_RandomEngine);
     // PX_TRACE("Got random number: {0}", result);
     return result;
 }
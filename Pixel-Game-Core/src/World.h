@@ -2,6 +2,7 @@
 
 #include "Chunk.h"
 #include "PixelBody2D.h"
+#include "Pyxis/Core/BitmaskFloodFill.h"
 #include "Pyxis/FastNoiseLite/FastNoiseLite.h"
 #include "Pyxis/Game/PhysicsBody2D.h"
 
@@ -11,58 +12,16 @@
 // Particles
 #include "ElementParticle.h"
 #include <random>
+#include <span>
 
-namespace Pyxis {
-
-namespace Utils {
-// GridQueuePull will fetch a continuous section of the grid set directly out of
-// source, destructive! There could still be more things in source if there were
-// non-continuous items. You want to keep pulling till source is empty.
-// defined here due to template in header at the bottom of the page.
-static std::unordered_set<glm::ivec2, VectorHash>
-GridQueuePull(std::unordered_set<glm::ivec2, VectorHash> &source) {
-    std::unordered_set<glm::ivec2, VectorHash> result;
-
-    if (source.size() == 0)
-        return result;
-
-    // make sure the start pos is valid
-    glm::ivec2 startPos = *source.begin();
-
-    // we make a queue of positions to check
-    std::queue<glm::ivec2> queue;
-
-    queue.push(startPos);
-    result.insert(startPos);
-    source.erase(
-        startPos); // since we know it is valid, and it won't be reached by loop
-
-    const glm::ivec2 neighbors[] = {
-        {1, 0},
-        {-1, 0},
-        {0, 1},
-        {0, -1},
-    };
+// multithreaded chunk updates
+#include "ChunkWorker.h"
 
-    while (queue.size() > 0) {
-        // check neighbors to see if we need to add them to the queue, or
-        // have already visited them
-        glm::ivec2 position = queue.front();
-        queue.pop();
-
-        for (int i = 0; i < 4; i++) {
-            glm::ivec2 pos = position + neighbors[i];
-            if (!result.contains(pos) && source.contains(pos)) {
-                queue.push(pos);
-                result.insert(pos);
-                source.erase(pos);
-            }
-        }
-    }
-    return result;
-}
+// streaming chunks out to disk, and generating them ahead of time
+#include "ChunkGenerator.h"
+#include "ChunkStorage.h"
 
-} // namespace Utils
+namespace Pyxis {
 
 class World {
   public:
@@ -70,8 +29,12 @@ class World {
     void Initialize(int worldSeed);
 
     enum class GameDataMsgType : uint8_t { pixelbody, chunk };
+    // how a chunk is stored in a Server_GameDataChunk message
+    enum class SnapshotEncoding : uint8_t { Full, Delta };
     void DownloadWorldInit(Network::Message &msg);
-    void DownloadWorld(Network::Message &msg);
+    // loads a game data message, and returns how many pixel bodies or chunks
+    // were in it
+    uint32_t DownloadWorld(Network::Message &msg);
     void GetGameDataInit(Network::Message &msg);
     void GetGameData(std::vector<Network::Message> &messages);
     // void GetWorldData(Network::Message& msg);
@@ -79,16 +42,34 @@ class World {
     ~World();
 
     Chunk *AddChunk(const glm::ivec2 &chunkPos);
+    // adds every chunk that isn't loaded yet in one go, generating the new
+    // ones in parallel on the chunk workers
+    void AddChunks(std::span<const glm::ivec2> chunkPositions);
     Chunk *GetChunk(const glm::ivec2 &chunkPos);
+    // takes a chunk out of the pool and resets it to chunkPos, or makes a new
+    // one if the pool is empty
+    Chunk *AcquireChunk(const glm::ivec2 &chunkPos);
+    // hands a chunk that is no longer part of the world back to the pool,
+    // destroying its physics body
+    void ReleaseChunk(Chunk *chunk);
+    // puts a newly created chunk into m_Chunks and m_ChunkOrder, links it
+    // with the loaded chunks around it, and gives it its physics body
+    void InsertChunk(Chunk *chunk);
+    // connects a newly loaded chunk with the loaded chunks around it
+    void LinkChunk(Chunk *chunk);
+    // fills an empty chunk with terrain. only reads the noise and element
+    // data, so different chunks can be generated on different threads.
     void GenerateChunk(Chunk *chunk);
+    // the same terrain, written into empty planes for the chunk at chunkPos
+    void GenerateChunk(const glm::ivec2 &chunkPos, ChunkPlanes &planes);
 
     // gets the requested element, undefined behavior if the chunk doesn't
     // exist!
-    Element &GetElement(const glm::ivec2 &pixelPos);
+    ElementRef GetElement(const glm::ivec2 &pixelPos);
     // Tries to get element if chunk exists
     bool TryGetElement(const glm::ivec2 &pixelPos, Element &element);
     // loads the chunk if it doesn't exist, then gets the element
-    Element &ForceGetElement(const glm::ivec2 &pixelPos);
+    ElementRef ForceGetElement(const glm::ivec2 &pixelPos);
 
     void SetElement(const glm::ivec2 &pixelPos, const Element &element);
     void SetElementWithoutDirtyRectUpdate(const glm::ivec2 &pixelPos,
@@ -102,6 +83,33 @@ class World {
     void UpdateChunk(Chunk *chunk);
     void UpdateChunkDirtyRect(int x, int y, Chunk *chunk);
 
+    // puts the chunk in the active set so it is visited next update. safe to
+    // call while chunks are being updated in parallel.
+    void WakeChunk(Chunk *chunk);
+    // drops settled chunks out of the active set
+    void SleepSettledChunks();
+
+    // writes settled chunks that are far from every pixel body and streaming
+    // anchor out to disk. AddChunk reads them back in when they are needed.
+    void EvictDistantChunks();
+    // moves the client's streaming anchor, making it if the client has none.
+    // only ever called from a tick closure, so every machine agrees on it.
+    void SetStreamingAnchor(HSteamNetConnection clientID,
+                            const glm::vec2 &position);
+    // reads any evicted neighbors of the chunk back in, so updating its border
+    // sees the same world it would have if nothing had been evicted
+    void LoadEvictedNeighbors(Chunk *chunk);
+    // reads every evicted chunk back in
+    void LoadAllEvictedChunks();
+
+    // starts generating chunks around the streaming anchors and pixel bodies,
+    // and where particles are headed, before anything touches them
+    void PrefetchChunks();
+    // returns false if the generator is full of chunks that are still wanted
+    bool PrefetchChunk(const glm::ivec2 &chunkPos);
+    // returns everything the generator is holding to the chunk pool
+    void DropPrefetchedChunks();
+
     // ElementParticle system
     std::vector<ElementParticle> m_ElementParticles;
     void CreateParticle(const glm::vec2 &position, const glm::vec2 &velocity,
@@ -113,7 +121,13 @@ class World {
     void RenderWorld();
 
     void TestMeshGeneration() {
-        for (auto &[key, chunk] : m_Chunks) {
+        // chunks can wake up in any order while updating in parallel, so sort
+        // them to add shapes to the physics world in the same order everywhere
+        std::sort(m_ActiveChunks.begin(), m_ActiveChunks.end(),
+                  [](Chunk *a, Chunk *b) {
+                      return IVec2Compare()(a->m_ChunkPos, b->m_ChunkPos);
+                  });
+        for (Chunk *chunk : m_ActiveChunks) {
             if (chunk->m_MeshChanged)
                 chunk->GenerateMesh();
         }
@@ -125,7 +139,7 @@ class World {
     // world.
     template <typename T = PixelBody2D>
     Ref<T> CreatePixelBody(const PhysicsBody2DDef &def,
-                           std::unordered_set<glm::ivec2, VectorHash> pixels,
+                           std::span<const glm::ivec2> pixels,
                            bool CheckIfContinuous = true,
                            const std::string &name = "PixelBody2D");
 
@@ -151,9 +165,10 @@ class World {
     // void HandleTickClosure(MergedTickClosure& tc);
     // Player* CreatePlayer(uint64_t playerID, glm::ivec2 position);
 
-    // random number generation
-    std::mt19937 m_RandomEngine;
-    std::uniform_int_distribution<int> m_Rand =
+    // random number generation, one engine per thread so chunks that are
+    // updated in parallel each get their own seeded sequence.
+    inline static thread_local std::mt19937 s_RandomEngine;
+    inline static thread_local std::uniform_int_distribution<int> s_Rand =
         std::uniform_int_distribution<int>(0, 99);
     std::uniform_int_distribution<uint32_t> dist;
     void SeedRandom(int xPos, int yPos);
@@ -165,11 +180,66 @@ class World {
     glm::ivec2 PixelToChunk(const glm::ivec2 &pixelPos);
     glm::ivec2 PixelToIndex(const glm::ivec2 &pixelPos);
 
-    // map of chunks, ordered so we update in the same order across machines
-    std::map<glm::ivec2, Chunk *> m_Chunks;
-
-    // keeping track of theads to join them
-    // std::vector<std::thread> m_Threads;
+    // every loaded chunk, hashed by chunk position for constant time lookups
+    std::unordered_map<glm::ivec2, Chunk *, VectorHash> m_Chunks;
+    // the same chunks sorted by position, for anything that has to walk them
+    // in the same order across machines
+    std::vector<Chunk *> m_ChunkOrder;
+
+    // unloaded chunks waiting to be reused, so loading and clearing don't
+    // churn through allocations and textures
+    std::vector<Chunk *> m_ChunkPool;
+    static constexpr size_t s_MaxPooledChunks = 256;
+
+    // chunks evicted to disk, and what keeps chunks from being evicted. chunks
+    // within s_EvictionRadius chunks of a pixel body or a streaming anchor
+    // stay loaded. anchors are world positions, one per client, sent as the
+    // client's camera in its tick closure. an anchor that hasn't been moved in
+    // s_AnchorTimeout ticks belongs to a client that left, and is dropped.
+    struct StreamingAnchor {
+        HSteamNetConnection m_ClientID;
+        glm::vec2 m_Position;
+        uint64_t m_LastTick;
+    };
+    ChunkStorage m_ChunkStorage;
+    std::vector<StreamingAnchor> m_StreamingAnchors;
+    static constexpr uint64_t s_AnchorTimeout = 600;
+    static constexpr int s_EvictionRadius = 6;
+    static constexpr uint64_t s_EvictionInterval = 60;
+
+    // chunks generated ahead of time, waiting for AddChunk to ask for them.
+    // they aren't part of the world until then, and have no texture or
+    // physics body either, so the simulation is the same no matter what was
+    // prefetched.
+    ChunkGenerator m_ChunkGenerator{
+        [this](Chunk *chunk) { GenerateChunk(chunk); }};
+    static constexpr int s_PrefetchRadius = 3;
+    static constexpr int s_PrefetchBodyRadius = 2;
+    static constexpr float s_PrefetchParticleTicks = 30;
+    static constexpr size_t s_MaxPrefetchedChunks = 64;
+    // the positions PrefetchChunks wants this tick, in the order it found
+    // them
+    std::vector<glm::ivec2> m_PrefetchOrder;
+    std::unordered_set<glm::ivec2, VectorHash> m_PrefetchWanted;
+
+    // world snapshots for joining clients are encoded this many chunks at a
+    // time, and packed into messages of about this many bytes
+    static constexpr size_t s_SnapshotBatchSize = 32;
+    static constexpr size_t s_SnapshotMessageBytes = 64 * 1024;
+
+    // worker pool for updating chunks, and the chunks of the phase currently
+    // being dispatched to it
+    ChunkWorker m_ChunkWorker;
+    std::vector<Chunk *> m_PhaseChunks;
+    // chunks being brought in by AddChunks, and the ones among them that
+    // need generating
+    std::vector<Chunk *> m_NewChunks;
+    std::vector<Chunk *> m_ChunksToGenerate;
+
+    // chunks that have a dirty rect or a mesh to rebuild. only these are
+    // simulated, uploaded and meshed, the rest of m_Chunks costs nothing.
+    std::vector<Chunk *> m_ActiveChunks;
+    std::mutex m_ActiveChunksMutex;
 
     // extra data needed
     bool m_Running = true;    // Needs to be synchronized
@@ -191,82 +261,80 @@ class World {
 
 template <typename T>
 Ref<T> World::CreatePixelBody(const PhysicsBody2DDef &def,
-                              std::unordered_set<glm::ivec2, VectorHash> pixels,
+                              std::span<const glm::ivec2> pixels,
                               bool CheckIfContinuous, const std::string &name) {
     static_assert(std::is_base_of_v<PixelBody2D, T>,
                   "T must inherit from PixelBody2D");
 
-    // restrict pixels to solids
-    std::unordered_set<glm::ivec2, VectorHash> pixelsRestricted;
+    if (pixels.size() == 0) {
+        PX_CORE_ERROR("Tried creating a pixel body with no elements!");
+        return nullptr;
+    }
+
+    // restrict pixels to solids, in a mask over the bounds of the pixels
+    glm::ivec2 minimum = {INT_MAX, INT_MAX};
+    glm::ivec2 maximum = {INT_MIN, INT_MIN};
     for (auto &pos : pixels) {
-        Element &e = ForceGetElement(pos);
-        ElementProperties &eData = ElementData::GetElementProperties(e.m_ID);
-        if (eData.cell_type == ElementType::solid ||
-            eData.cell_type == ElementType::movableSolid) {
-            pixelsRestricted.insert(pos);
+        minimum = glm::min(minimum, pos);
+        maximum = glm::max(maximum, pos);
+    }
+    ColumnBitmask pixelsRestricted(maximum.x - minimum.x + 1,
+                                   maximum.y - minimum.y + 1);
+    size_t restrictedCount = 0;
+    for (auto &pos : pixels) {
+        ElementRef e = ForceGetElement(pos);
+        if (ElementData::IsColliderSolid(e.m_ID)) {
+            pixelsRestricted.Set(pos - minimum);
+            restrictedCount++;
         }
     }
 
-    if (pixelsRestricted.size() == 0) {
+    if (restrictedCount == 0) {
         // PX_ASSERT(false, "Tried creating a pixel body with no elements!");
         PX_CORE_ERROR("Tried creating a pixel body with no elements!");
         return nullptr;
     }
 
-    // we have a vector of pixels to make a body from, but we don't know if they
-    // are continuous
-    if (CheckIfContinuous) {
-        int iterations = 0;
-        while (pixelsRestricted.size() > 0) {
-            std::unordered_set<glm::ivec2, VectorHash> continuousPixels =
-                Utils::GridQueuePull(pixelsRestricted);
-            std::string newName =
-                name + (iterations > 0 ? std::format(" ({})", iterations) : "");
-            Ref<T> body = Instantiate<T>(newName, def);
-            std::vector<PixelBodyElement> elements;
-            for (glm::ivec2 pos : continuousPixels) {
-                Element e =
-                    GetElement(pos); // don't need to force since i did above
-                // e.m_BaseColor = 0xFFFFFFFF;
-                // e.m_Color = 0xFFFFFFFF;
-                elements.push_back(PixelBodyElement(e, pos));
-                e.m_Rigid = true;
-                SetElement(pos, e); // set the element back, but this time
-                                    // rigid.
-            }
-            body->SetPixelBodyElements(elements);
-            m_PixelBodies[body->GetUUID()] = body;
-
-            PX_TRACE("Instantiated {} with {} pixels", newName,
-                     continuousPixels.size());
-
-            if (pixelsRestricted.size() == 0) {
-                // we pulled the last of the pixels, so return this body.
-                return body;
-            }
-            iterations++;
-        }
-    } else {
-        Ref<T> body = Instantiate<T>(name, def);
+    // pulls the pixels out of the world into a new body
+    auto createBody = [&](const ColumnBitmask &mask,
+                          const std::string &bodyName) {
+        Ref<T> body = Instantiate<T>(bodyName, def);
         std::vector<PixelBodyElement> elements;
-        for (glm::ivec2 pos : pixelsRestricted) {
+        mask.ForEach([&](glm::ivec2 cell) {
+            glm::ivec2 pos = cell + minimum;
+            // don't need to force since i did above
             Element e = GetElement(pos);
             // e.m_BaseColor = 0xFFFFFFFF;
             // e.m_Color = 0xFFFFFFFF;
             elements.push_back(PixelBodyElement(e, pos));
             e.m_Rigid = true;
-            SetElement(pos, e);
-        }
+            SetElement(pos, e); // set the element back, but this time rigid.
+        });
         body->SetPixelBodyElements(elements);
         m_PixelBodies[body->GetUUID()] = body;
-        PX_TRACE("Instantiated {} with {} pixels", name,
-                 pixelsRestricted.size());
 
+        PX_TRACE("Instantiated {} with {} pixels", bodyName, elements.size());
         return body;
+    };
+
+    // we have a mask of pixels to make a body from, but we don't know if they
+    // are continuous
+    if (CheckIfContinuous) {
+        // one body for every continuous region, returning the last one made
+        Ref<T> body;
+        int iterations = 0;
+        ForEachConnectedRegion(
+            pixelsRestricted, [&](const ColumnBitmask &region) {
+                std::string newName =
+                    name +
+                    (iterations > 0 ? std::format(" ({})", iterations) : "");
+                body = createBody(region, newName);
+                iterations++;
+            });
+        return body;
+    } else {
+        return createBody(pixelsRestricted, name);
     }
-    // something went wrong!
-    PX_CORE_ERROR("Somehow, we didn't create a pixel body here...");
-    return nullptr;
 }
 
 } // namespace Pyxis
@@ -221,8 +221,7 @@ void GameNode::GameUpdate(Timestep ts) {
         auto it = m_World.m_Chunks.find(chunkPos);
         if (it != m_World.m_Chunks.end()) {
             auto index = m_World.PixelToIndex(mousePixelPos);
-            m_HoveredElement =
-                it->second->m_Elements[index.x + index.y * CHUNKSIZE];
+            m_HoveredElement = it->second->GetElement(index);
             if (m_HoveredElement.m_ID >= ElementData::s_ElementData.size()) {
                 // something went wrong? how?
                 m_HoveredElement = Element();
@@ -351,7 +350,7 @@ void GameNode::HandleTickClosure(MergedTickClosure &tc) {
                 tc >> brushSize;
                 tc >> pixelPos;
 
-                std::unordered_set<glm::ivec2, VectorHash> pixels;
+                std::vector<glm::ivec2> pixels;
                 // make a region around the mouse, and turn it into a pixel body
                 for (int x = -brushSize; x <= brushSize; x++) {
                     for (int y = -brushSize; y <= brushSize; y++) {
@@ -372,7 +371,7 @@ void GameNode::HandleTickClosure(MergedTickClosure &tc) {
 
                         glm::ivec2 worldPos = glm::ivec2(x, y) + pixelPos;
 
-                        pixels.insert(worldPos);
+                        pixels.push_back(worldPos);
                     }
                 }
                 if (pixels.size() > 0) {
@@ -404,6 +403,12 @@ void GameNode::HandleTickClosure(MergedTickClosure &tc) {
                 m_ClientDataMap[clientID].m_CursorWorldPosition = mousePos;
                 break;
             }
+            case InputAction::Input_CameraPosition: {
+                glm::vec2 cameraPos;
+                tc >> cameraPos;
+                m_World.SetStreamingAnchor(clientID, cameraPos);
+                break;
+            }
             case InputAction::ClearWorld: {
                 m_World.Clear();
                 break;
@@ -423,6 +428,12 @@ void GameNode::HandleTickClosure(MergedTickClosure &tc) {
     }
 }
 
+void GameNode::AddCameraPositionInput() {
+    glm::vec2 cameraPos = Camera::Main()->GetPosition();
+    m_CurrentTickClosure.AddInputAction(InputAction::Input_CameraPosition,
+                                        cameraPos);
+}
+
 glm::ivec2 GameNode::GetMousePositionImGui() {
     /// if not using a framebuffer / imgui image, just use
     /// Pyxis::Input::GetMousePosition();
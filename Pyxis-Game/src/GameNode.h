@@ -63,6 +63,9 @@ class GameNode : public Node {
     void GameUpdate(Timestep ts);
     // virtual void ClientImGuiRender();
     void HandleTickClosure(MergedTickClosure &tc);
+    // puts the camera into the tick closure, where it becomes this client's
+    // streaming anchor on every machine
+    void AddCameraPositionInput();
 
     void PaintBrushHologram();
     void TextCentered(std::string text);
@@ -26,52 +26,49 @@ void HostedGameNode::OnUpdate(Timestep ts) {
 void HostedGameNode::OnFixedUpdate() {
     PROFILE_SCOPE("Simulation Update");
 
-    // skip sending the message if we are waiting for a client to connect!
-    if (m_DownloadingClients.empty()) {
-        // first, since we are also playing, put our tick closure into the mtc
-        m_CurrentMergedTickClosure.AddTickClosure(
-            m_CurrentTickClosure, k_HSteamNetConnection_Invalid);
-
-        // pack the merged tick into a message and send to all clients
-        Network::Message msg(
-            static_cast<uint32_t>(GameMessage::Game_MergedTickClosure));
-        msg << m_CurrentMergedTickClosure.m_Data;
-        msg << m_CurrentMergedTickClosure.m_ClientCount;
-        msg << m_InputTick;
-
-        // send the messages unreliably, since i have mtc recovery set up
-        // already!
-        SendMessageToAllClients(msg, 0, k_nSteamNetworkingSend_Unreliable);
-
-        // add the compressed message into the tick storage
-        m_TickRequestStorage.emplace_back();
-        msg.Compressed(m_TickRequestStorage.back());
-
-        // limit the tick storage to "MaxTickStorage"
-        if (m_TickRequestStorage.size() > MaxTickStorage)
-            m_TickRequestStorage.pop_front();
-
-        // process the mtc on the our end
-        HandleTickClosure(m_CurrentMergedTickClosure);
-        m_InputTick++;
-
-        // reset the merged tick
-        m_CurrentMergedTickClosure = MergedTickClosure();
-
-        // reset tick closure
-        m_CurrentTickClosure = TickClosure();
-
-        // update player mouse positions
-        Network::Message mousePosMsg;
-        mousePosMsg.header.id =
-            static_cast<uint32_t>(GameMessage::Server_ClientDataMousePosition);
-        m_ClientData.m_CursorWorldPosition = GetMousePosWorld();
-        // invalid for the server
-        HSteamNetConnection serverConn = k_HSteamNetConnection_Invalid;
-        mousePosMsg << m_ClientData.m_CursorWorldPosition;
-        mousePosMsg << serverConn;
-        SendMessageToAllClients(mousePosMsg);
-    }
+    // first, since we are also playing, put our tick closure into the mtc
+    AddCameraPositionInput();
+    m_CurrentMergedTickClosure.AddTickClosure(m_CurrentTickClosure,
+                                              k_HSteamNetConnection_Invalid);
+
+    // pack the merged tick into a message and send to all clients
+    Network::Message msg(
+        static_cast<uint32_t>(GameMessage::Game_MergedTickClosure));
+    msg << m_CurrentMergedTickClosure.m_Data;
+    msg << m_CurrentMergedTickClosure.m_ClientCount;
+    msg << m_InputTick;
+
+    // compress it once, the same payload is broadcast, stored, and resent
+    Ref<std::string> payload = CreatePayload(msg);
+
+    // send the messages unreliably, since i have mtc recovery set up
+    // already!
+    SendPayloadToAllClients(payload, 0, k_nSteamNetworkingSend_Unreliable);
+
+    // add the compressed message into the tick storage. anyone still
+    // downloading gets their ticks from here once they are done
+    m_TickStorage.Store(m_InputTick, payload);
+
+    // process the mtc on the our end
+    HandleTickClosure(m_CurrentMergedTickClosure);
+    m_InputTick++;
+
+    // reset the merged tick
+    m_CurrentMergedTickClosure = MergedTickClosure();
+
+    // reset tick closure
+    m_CurrentTickClosure = TickClosure();
+
+    // update player mouse positions
+    Network::Message mousePosMsg;
+    mousePosMsg.header.id =
+        static_cast<uint32_t>(GameMessage::Server_ClientDataMousePosition);
+    m_ClientData.m_CursorWorldPosition = GetMousePosWorld();
+    // invalid for the server
+    HSteamNetConnection serverConn = k_HSteamNetConnection_Invalid;
+    mousePosMsg << m_ClientData.m_CursorWorldPosition;
+    mousePosMsg << serverConn;
+    SendMessageToAllClients(mousePosMsg);
 }
 
 void HostedGameNode::OnImGuiRender() {
@@ -93,7 +90,7 @@ void HostedGameNode::StartIP(uint16_t port) {
 }
 
 void HostedGameNode::HandleMessages() {
-    Ref<Network::Message> msg;
+    Network::Message *msg;
     while (PollMessage(msg)) {
         switch (static_cast<GameMessage>(msg->header.id)) {
         case GameMessage::Client_ClientData: {
@@ -147,21 +144,12 @@ void HostedGameNode::HandleMessages() {
             break;
         }
         case GameMessage::Client_RequestMergedTick: {
-            // assuming there are 66 mtc's stored
-            // m_inputtick is then 67
-            // if tick 65 was requested, then that would be located at position
-            // 64 which is 66 - (67 - 65)
-            //          66 -  2 = 64
-            // that is the reasoning for the calculation below
-            // basically, the difference between the current tick and how far
-            // back the request is, is how far back from the end of the storage
-            // to grab from
-
+            // the storage is indexed by tick, and reads ticks that have been
+            // spilled back from disk, so only ticks we never sent are missing
             uint64_t tick;
             *msg >> tick;
-            int diff = m_InputTick - tick;
-            int position = m_TickRequestStorage.size() - diff;
-            if (position < 0 || position >= m_TickRequestStorage.size()) {
+            Ref<std::string> payload = m_TickStorage.Get(tick);
+            if (!payload) {
                 // Requested tick does not exist!
                 PX_WARN("Requested Tick Not Found, setting client to be out of "
                         "sync!");
@@ -169,51 +157,46 @@ void HostedGameNode::HandleMessages() {
                                  "Client Became Desynced (Requested a tick we "
                                  "no longer had!)");
             } else
-                SendCompressedStringToClient(msg->clientHConnection,
-                                             m_TickRequestStorage.at(position));
+                SendPayloadToClient(msg->clientHConnection, payload);
 
             break;
         }
         case GameMessage::Client_RequestGameData: {
-            // TODO:
-            // maybe send some info to other clients? so their game doesn't just
-            // randomly stop...
-
-            // begin by halting the game for this client to join the world
-            // then, send the initializing message, saying how many chunks need
-            // to be sent, and how many rigid bodies?
-            // then send all the chunks individually and send pixel bodies in
-            // groups as well? or maybe individually.
+            // the game keeps going while this client joins. we capture the
+            // world as it is before m_InputTick, send it over, and hold on to
+            // every mtc from m_InputTick on until the client has loaded it,
+            // so it can run them to catch up.
 
             // now, lets send that initial message describing how many chunks we
             // will send and how many pixel bodies there are.
             Network::Message gameDataInitMsg;
             m_World.GetGameDataInit(gameDataInitMsg);
-            gameDataInitMsg << m_InputTick;
-            SendMessageToClient(msg->clientHConnection, gameDataInitMsg);
 
             // now lets populate a vector of messages to be sent,
             // being the chunks and pixel bodies
-            // this is also how we track pausing to let someone download
-            m_DownloadingClients[msg->clientHConnection] =
-                std::vector<Network::Message>();
-            // PX_WARN("Created a vector of messages for client");
-            m_World.GetGameData(m_DownloadingClients[msg->clientHConnection]);
-            // send the first and wait for it to be acknowledged
-
-            if (!m_DownloadingClients[msg->clientHConnection].empty()) {
-                PX_TRACE(
-                    "Sent GameDataMsg: ID[{0}], Size[{1}]",
-                    m_DownloadingClients[msg->clientHConnection]
-                        .back()
-                        .header.id,
-                    m_DownloadingClients[msg->clientHConnection].back().size());
-                SendMessageToClient(
-                    msg->clientHConnection,
-                    m_DownloadingClients[msg->clientHConnection].back());
-                m_DownloadingClients[msg->clientHConnection].pop_back();
+            WorldDownload &download =
+                m_DownloadingClients[msg->clientHConnection];
+            download = WorldDownload();
+            download.m_SnapshotTick = m_InputTick;
+            m_World.GetGameData(download.m_Messages);
+            // the chunks go out first
+            std::reverse(download.m_Messages.begin(),
+                         download.m_Messages.end());
+            uint64_t downloadBytes = 0;
+            for (Network::Message &gameDataMsg : download.m_Messages) {
+                download.m_MessageSizes.push_back(gameDataMsg.size());
+                downloadBytes += gameDataMsg.size();
             }
 
+            // the client reports progress in bytes, and is done once it has
+            // every message
+            gameDataInitMsg << m_InputTick;
+            gameDataInitMsg << downloadBytes;
+            gameDataInitMsg << static_cast<uint32_t>(
+                download.m_Messages.size());
+            SendMessageToClient(msg->clientHConnection, gameDataInitMsg);
+            SendWorldDownload(msg->clientHConnection);
+
             // as soon as a new client joins the game,
             // we have to reset everyones box2d simulation, so send that now so
             // everyone stays in sync!
@@ -226,24 +209,49 @@ void HostedGameNode::HandleMessages() {
             break;
         }
         case GameMessage::Client_GameDataRecieved: {
-            PX_TRACE(
-                "Sent GameDataMsg: ID[{0}], Size[{1}]",
-                m_DownloadingClients[msg->clientHConnection].back().header.id,
-                m_DownloadingClients[msg->clientHConnection].back().size());
-            SendMessageToClient(
-                msg->clientHConnection,
-                m_DownloadingClients[msg->clientHConnection].back());
-            m_DownloadingClients[msg->clientHConnection].pop_back();
-            PX_WARN("Sent GameDataPacket. Remaining: {0}",
-                    m_DownloadingClients[msg->clientHConnection].size());
+            auto it = m_DownloadingClients.find(msg->clientHConnection);
+            if (it == m_DownloadingClients.end())
+                break;
+            // acks are cumulative, so a late one can't move us backwards
+            uint32_t received;
+            *msg >> received;
+            WorldDownload &download = it->second;
+            download.m_Acknowledged = std::max(
+                download.m_Acknowledged, std::min(received, download.m_Sent));
+            SendWorldDownload(msg->clientHConnection);
             break;
         }
         case GameMessage::Client_GameDataComplete: {
-            // the connecting client finished loading the world, so lets resume!
-            if (m_DownloadingClients[msg->clientHConnection].empty()) {
-                PX_WARN("Erased Client. DLCL Size: {0}",
-                        m_DownloadingClients.size());
-                m_DownloadingClients.erase(msg->clientHConnection);
+            // the connecting client finished loading the world, so send it
+            // everything that happened since, out of the tick storage
+            auto it = m_DownloadingClients.find(msg->clientHConnection);
+            if (it == m_DownloadingClients.end() ||
+                it->second.m_Sent != it->second.m_Messages.size())
+                break;
+            uint64_t snapshotTick = it->second.m_SnapshotTick;
+            m_DownloadingClients.erase(it);
+            PX_WARN("Erased Client. DLCL Size: {0}",
+                    m_DownloadingClients.size());
+
+            std::vector<Ref<std::string>> ticks;
+            ticks.reserve(m_InputTick - snapshotTick);
+            for (uint64_t tick = snapshotTick; tick < m_InputTick; tick++) {
+                Ref<std::string> payload = m_TickStorage.Get(tick);
+                if (!payload) {
+                    // took so long the storage let go of where it started
+                    PX_WARN("Client fell behind the tick storage while "
+                            "downloading");
+                    DisconnectClient(msg->clientHConnection,
+                                     "Client Became Desynced (Took too long "
+                                     "to download the world!)");
+                    ticks.clear();
+                    break;
+                }
+                ticks.push_back(payload);
+            }
+            if (!ticks.empty()) {
+                PX_TRACE("Sending {0} ticks to catch up on", ticks.size());
+                SendPayloadsToClient(msg->clientHConnection, ticks);
             }
             break;
         }
@@ -263,9 +271,33 @@ void HostedGameNode::HandleMessages() {
     }
 }
 
+void HostedGameNode::SendWorldDownload(HSteamNetConnection client) {
+    WorldDownload &download = m_DownloadingClients[client];
+    uint64_t bytesInFlight = 0;
+    for (uint32_t i = download.m_Acknowledged; i < download.m_Sent; i++) {
+        bytesInFlight += download.m_MessageSizes[i];
+    }
+
+    while (download.m_Sent < download.m_Messages.size()) {
+        uint32_t size = download.m_MessageSizes[download.m_Sent];
+        // always keep one going, even if it is bigger than the window
+        if (bytesInFlight > 0 && bytesInFlight + size > DownloadWindowBytes)
+            break;
+        SendMessageToClient(client, download.m_Messages[download.m_Sent]);
+        // nothing needs it once it is out
+        download.m_Messages[download.m_Sent] = Network::Message();
+        bytesInFlight += size;
+        download.m_Sent++;
+    }
+    PX_TRACE("Sent GameData {0}/{1}, {2} bytes in flight", download.m_Sent,
+             download.m_Messages.size(), bytesInFlight);
+}
+
 void HostedGameNode::OnClientDisconnect(HSteamNetConnection &client) {
     if (m_ClientDataMap.contains(client))
         m_ClientDataMap.erase(client);
+    // stop sending a download nobody will finish
+    m_DownloadingClients.erase(client);
 }
 
 void HostedGameNode::ReturnToMenu() {
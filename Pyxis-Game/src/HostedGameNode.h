@@ -1,5 +1,6 @@
 #pragma once
 #include "GameNode.h"
+#include "TickStorage.h"
 #include <Pyxis/Network/NetworkServer.h>
 #include <steam/isteamfriends.h>
 
@@ -11,7 +12,16 @@ namespace Pyxis
 	{
 	public:
 
+		//how many ticks are kept in memory for clients that miss one, and at
+		//most how many bytes of them. older ones are spilled to disk, and
+		//past the most ticks kept on disk the oldest are deleted
 		static const int MaxTickStorage = 500;
+		static const size_t MaxTickStorageBytes = 4 * 1024 * 1024;
+		static const size_t MaxSpilledTicks = 100000;
+
+		//how many bytes of world download can be unacknowledged at once.
+		//kept under the default send buffer of the connection
+		static const uint64_t DownloadWindowBytes = 384 * 1024;
 
 
 		HostedGameNode(std::string name = "Hosted Game Node") : GameNode(name) 
@@ -42,6 +52,7 @@ namespace Pyxis
 		void StartP2P(int virtualPort = 0);
 		void StartIP(uint16_t port = PX_DEFAULT_PORT);
 		void HandleMessages();
+		void SendWorldDownload(HSteamNetConnection client);
 
 		//////////////////////////////////////
 		/// Server Function Overrides
@@ -62,12 +73,26 @@ namespace Pyxis
 
 		MergedTickClosure m_CurrentMergedTickClosure;
 
+		//a world download in progress. messages go out in order, as long as
+		//the client has acknowledged enough of the earlier ones
+		struct WorldDownload
+		{
+			std::vector<Network::Message> m_Messages;
+			std::vector<uint32_t> m_MessageSizes;
+			uint32_t m_Sent = 0;
+			uint32_t m_Acknowledged = 0;
+			//the first tick after the world was captured. the client runs
+			//every tick from here on to catch up once it has the world, read
+			//back out of the tick storage
+			uint64_t m_SnapshotTick = 0;
+		};
+
 		//map of clients world download progress / messages
-		std::unordered_map<HSteamNetConnection, std::vector<Network::Message>> m_DownloadingClients;
+		std::unordered_map<HSteamNetConnection, WorldDownload> m_DownloadingClients;
 
-		//a deque of the compressed mtc messages! allows for a smaller storage of the tick closures
+		//the compressed mtc messages by tick! allows for a smaller storage of the tick closures
 		//and so they can be requested by a client if one goes missing
-		std::deque<std::string> m_TickRequestStorage;
+		TickStorage m_TickStorage{ MaxTickStorage, MaxTickStorageBytes, MaxSpilledTicks };
 
 	};
 }
@@ -80,13 +80,19 @@ void MultiplayerGameNode::OnUpdate(Timestep ts) {
         HandleMessages();
     }
 
-    if (m_MultiplayerState == MultiplayerState::Connected) {
-        while (!m_MTCBuffer.empty()) {
+    if (m_MultiplayerState == MultiplayerState::CatchingUp ||
+        m_MultiplayerState == MultiplayerState::Connected) {
+        // the ticks that went by while we downloaded the world are run a few
+        // at a time, so the game keeps drawing while we catch up
+        int tickBudget = m_MultiplayerState == MultiplayerState::CatchingUp
+                             ? CatchUpTicksPerFrame
+                             : std::numeric_limits<int>::max();
+        while (!m_MTCBuffer.empty() && tickBudget > 0) {
             if (m_MTCBuffer.front().m_Tick == m_InputTick) {
                 // the front tick is what we want, so let's just handle it
-                HandleTickClosure(m_MTCBuffer.front());
+                ApplyTickClosure(m_MTCBuffer.front());
                 m_MTCBuffer.pop_front();
-                m_InputTick++;
+                tickBudget--;
             } else if (m_MTCBuffer.front().m_Tick < m_InputTick) {
                 // this tick is old, so discard it
                 m_MTCBuffer.pop_front();
@@ -98,11 +104,22 @@ void MultiplayerGameNode::OnUpdate(Timestep ts) {
                         GameMessage::Client_RequestMergedTick));
                     requestMsg << m_InputTick;
                     SendMessageToServer(requestMsg);
+                    m_LastRequestedTick = m_InputTick;
                     PX_TRACE("MTC Skipped, Requesting Missing Tick");
                 }
                 break;
             }
         }
+
+        if (m_MultiplayerState == MultiplayerState::CatchingUp &&
+            m_MTCBuffer.empty()) {
+            // we have run everything we were sent, so we are playing now!
+            PX_INFO("Caught up at tick [{0}]", m_InputTick);
+            m_MultiplayerState = MultiplayerState::Connected;
+            m_LSCanvas->m_Enabled = false;
+            m_LSText->m_Enabled = false;
+            m_LSButton->m_Enabled = false;
+        }
     }
 
     if (m_MultiplayerState == MultiplayerState::Connected &&
@@ -124,14 +141,9 @@ void MultiplayerGameNode::OnFixedUpdate() {
     if (m_MultiplayerState == MultiplayerState::Connected) {
         PROFILE_SCOPE("Simulation Update");
 
-        // reset world, then apply the tick closure
-        if (m_World.m_SimulationTick == m_TickToResetBox2D) {
-            m_World.ResetPhysicsDeterminism();
-            m_TickToResetBox2D = -1;
-        }
-
         // for multiplayer, just send off your tick closure
         //(basically just your input shoved into a message)
+        AddCameraPositionInput();
         Network::Message msg;
         msg.header.id = static_cast<uint32_t>(GameMessage::Game_TickClosure);
         msg << m_CurrentTickClosure.m_Data;
@@ -155,10 +167,28 @@ void MultiplayerGameNode::OnRender() {
     if (m_MultiplayerState == MultiplayerState::DownloadingWorld) {
         m_LSText->m_Text =
             "Downloading World: { " +
-            std::to_string(((float)m_DownloadCount / (float)m_DownloadTotal) *
-                           100.0f) +
+            std::to_string(
+                ((float)m_DownloadedBytes / (float)m_DownloadTotalBytes) *
+                100.0f) +
             "% }";
     }
+    if (m_MultiplayerState == MultiplayerState::CatchingUp) {
+        m_LSText->m_Text =
+            "Catching Up: { " +
+            std::to_string(std::max<int64_t>(
+                0, (int64_t)d_LastRecievedInputTick - (int64_t)m_InputTick)) +
+            " ticks }";
+    }
+}
+
+void MultiplayerGameNode::ApplyTickClosure(MergedTickClosure &mtc) {
+    // reset world, then apply the tick closure
+    if (m_World.m_SimulationTick == m_TickToResetBox2D) {
+        m_World.ResetPhysicsDeterminism();
+        m_TickToResetBox2D = -1;
+    }
+    HandleTickClosure(mtc);
+    m_InputTick++;
 }
 
 void MultiplayerGameNode::OnConnectionSuccess() {
@@ -199,7 +229,7 @@ void MultiplayerGameNode::OnConnectionFailure(const std::string &reasonText) {
 }
 
 void MultiplayerGameNode::HandleMessages() {
-    Ref<Network::Message> msg;
+    Network::Message *msg;
     while (PollMessage(msg)) {
         // PX_TRACE("Recieved message from Server");
         switch (static_cast<GameMessage>(msg->header.id)) {
@@ -258,6 +288,8 @@ void MultiplayerGameNode::HandleMessages() {
         }
         case GameMessage::Server_GameDataInit: {
             PX_TRACE("Recieved Game Data");
+            *msg >> m_DownloadTotalMessages;
+            *msg >> m_DownloadTotalBytes;
             *msg >> m_InputTick;
 
             m_World.DownloadWorldInit(*msg);
@@ -265,59 +297,57 @@ void MultiplayerGameNode::HandleMessages() {
             uint32_t numChunks;
             *msg >> numPixelBodies >> numChunks;
 
-            m_DownloadTotal = static_cast<uint64_t>(numPixelBodies) +
-                              static_cast<uint64_t>(numChunks);
-            m_DownloadCount = 0;
+            m_DownloadedBytes = 0;
+            m_DownloadedMessages = 0;
 
             PX_TRACE("Downloading game at tick [{0}], simulation tick [{1}]",
                      m_InputTick, m_World.m_SimulationTick);
-            if (m_DownloadTotal == 0) {
+            if (m_DownloadTotalMessages == 0) {
                 PX_TRACE("The world is empty! hop on in!");
-                // tell the server we are finished, so it can resume the game
+                // tell the server we are finished, so it can send the ticks
+                // we missed
                 Network::Message finishedDownloadMsg;
                 finishedDownloadMsg.header.id =
                     static_cast<uint32_t>(GameMessage::Client_GameDataComplete);
                 SendMessageToServer(finishedDownloadMsg);
-                // we are connected!
-                m_MultiplayerState = MultiplayerState::Connected;
-                m_LSCanvas->m_Enabled = false;
-                m_LSText->m_Enabled = false;
-                m_LSButton->m_Enabled = false;
+                m_MultiplayerState = MultiplayerState::CatchingUp;
             } else {
-                PX_TRACE("Expecting {0} PixelBodies and {1} Chunks totalling "
-                         "{2} messages",
-                         numPixelBodies, numChunks, m_DownloadTotal);
+                PX_TRACE("Expecting {0} PixelBodies and {1} Chunks in {2} "
+                         "messages, totalling {3} bytes",
+                         numPixelBodies, numChunks, m_DownloadTotalMessages,
+                         m_DownloadTotalBytes);
             }
             break;
         }
         case GameMessage::Server_GameDataRigidBody:
         case GameMessage::Server_GameDataChunk: {
 
-            // we recieved a pixel body, so lets count it, and add it to the
-            // world
-            m_DownloadCount++;
+            // we recieved pixel bodies or chunks, so lets count them, and add
+            // them to the world
+            m_DownloadedBytes += msg->size();
+            m_DownloadedMessages++;
             m_World.DownloadWorld(*msg);
-            if (m_DownloadCount == m_DownloadTotal) {
+            if (m_DownloadedMessages == m_DownloadTotalMessages) {
                 PX_INFO("Downloading World: [100%]");
-                // tell the server we are finished, so it can resume the game
+                // tell the server we are finished, so it can send the ticks
+                // we missed
                 Network::Message gameDataCompleteMsg;
                 gameDataCompleteMsg.header.id =
                     static_cast<uint32_t>(GameMessage::Client_GameDataComplete);
                 SendMessageToServer(gameDataCompleteMsg);
 
                 // now that we have finished recieving the game data and loading
-                // the world, start the game!
-                m_MultiplayerState = MultiplayerState::Connected;
-                m_LSCanvas->m_Enabled = false;
-                m_LSText->m_Enabled = false;
-                m_LSButton->m_Enabled = false;
+                // the world, run the ticks that went by in the meantime
+                m_MultiplayerState = MultiplayerState::CatchingUp;
+                m_LSText->m_Text = "Catching Up...";
             } else {
+                // let the server know how far we are, so it can keep the
+                // rest coming
                 Network::Message gameDataRecievedMsg;
                 gameDataRecievedMsg.header.id =
                     static_cast<uint32_t>(GameMessage::Client_GameDataRecieved);
+                gameDataRecievedMsg << m_DownloadedMessages;
                 SendMessageToServer(gameDataRecievedMsg);
-                // PX_INFO("Downloading World: [{0}%]", (double)m_DownloadCount
-                // / (double)m_DownloadTotal);
             }
             break;
         }
@@ -328,17 +358,25 @@ void MultiplayerGameNode::HandleMessages() {
             *msg >> mtc.m_Data;
             d_LastRecievedInputTick = mtc.m_Tick;
 
-            // if this tick is the current one, handle it immediately,
-            //  don't need to push it to the front of the buffer
-            if (mtc.m_Tick == m_InputTick) {
-                HandleTickClosure(mtc);
-                m_InputTick++;
-            } else if (mtc.m_Tick == m_InputTick) {
+            // if this tick is the current one and we are playing, handle it
+            // immediately, don't need to push it to the front of the buffer
+            if (m_MultiplayerState == MultiplayerState::Connected &&
+                mtc.m_Tick == m_InputTick) {
+                ApplyTickClosure(mtc);
+            } else if (mtc.m_Tick < m_InputTick) {
                 // also, if the tick is old just discard it.
                 // we only want to hand onto new ones.
             } else {
-                // this is a future tick, so lets throw it on the stack
-                m_MTCBuffer.push_back(mtc);
+                // this is a future tick, or we are still loading, so lets
+                // keep it in order. the server resends everything from our
+                // download, so skip any we already have
+                auto it = std::lower_bound(
+                    m_MTCBuffer.begin(), m_MTCBuffer.end(), mtc.m_Tick,
+                    [](const MergedTickClosure &buffered, uint64_t tick) {
+                        return buffered.m_Tick < tick;
+                    });
+                if (it == m_MTCBuffer.end() || it->m_Tick != mtc.m_Tick)
+                    m_MTCBuffer.insert(it, mtc);
             }
 
             break;
@@ -9,6 +9,11 @@ namespace Pyxis
 	class MultiplayerGameNode : public GameNode, public Network::ClientInterface
 	{
 	public:
+
+		//how many buffered ticks to run each frame while catching up after
+		//downloading the world
+		static const int CatchUpTicksPerFrame = 8;
+
 		MultiplayerGameNode();
 		virtual ~MultiplayerGameNode() = default;
 		
@@ -34,6 +39,10 @@ namespace Pyxis
 		void OnConnectionFailure(const std::string& reasonText) override;
 		void HandleMessages();
 
+		//runs the mtc for the current input tick, resetting box2d first if
+		//another player joined at this tick
+		void ApplyTickClosure(MergedTickClosure& mtc);
+
 
 	public:
 
@@ -62,15 +71,19 @@ namespace Pyxis
 		//used for limiting requests for missing ticks
 		uint64_t m_LastRequestedTick = -1;
 
-		//buffer to hold incoming MTC's, since we could get one out of order
+		//buffer to hold incoming MTC's, since we could get one out of order.
+		//kept sorted by tick
 		std::deque<MergedTickClosure> m_MTCBuffer;
 
 		//simulation tick to reset world at, for when other players join the same server as you.
 		uint64_t m_TickToResetBox2D = -1;
 
-		//for keeping track of world download progress
-		uint64_t m_DownloadCount = 0;
-		uint64_t m_DownloadTotal = 0;
+		//for keeping track of world download progress. progress is shown in
+		//bytes, and we are done once every message has arrived
+		uint64_t m_DownloadedBytes = 0;
+		uint64_t m_DownloadTotalBytes = 0;
+		uint32_t m_DownloadedMessages = 0;
+		uint32_t m_DownloadTotalMessages = 0;
 
 
 	};
@@ -38,6 +38,7 @@ class SinglePlayerGameNode : public GameNode {
 
         // for singleplayer, just construct your own merged tick and
         // handle it
+        AddCameraPositionInput();
         MergedTickClosure tc;
         tc.AddTickClosure(m_CurrentTickClosure, 0);
         HandleTickClosure(tc);
@@ -1,6 +1,7 @@
 #pragma once
 #include "Pyxis/Core/Log.h"
 #include <Pyxis/Core/Core.h>
+#include <unordered_map>
 
 namespace Pyxis {
 struct BGMQuad {
@@ -14,65 +15,178 @@ struct BGMQuad {
         halfHeight = half_height;
         center = center_pos;
     }
+
+    // the quad in whole bits. the floats are always whole or halves, so
+    // these are exact.
+    inline int Left() const { return (int)(center.x - halfWidth); }
+    inline int Bottom() const { return (int)(center.y - halfHeight); }
+    inline int Width() const { return (int)(halfWidth * 2.0f); }
+    inline int Height() const { return (int)(halfHeight * 2.0f); }
+
+    bool operator==(const BGMQuad &other) const {
+        return halfWidth == other.halfWidth &&
+               halfHeight == other.halfHeight && center == other.center;
+    }
 };
 
-// Processes a 2D binary mask where each column is a uint64_t (up to 64 columns)
+namespace Utils {
+inline BGMQuad MakeBGMQuad(int x, int y, int width, int height) {
+    float halfWidth = (float)width / 2.0f;
+    float halfHeight = (float)height / 2.0f;
+    return BGMQuad(halfWidth, halfHeight,
+                   glm::vec2((float)x + halfWidth, (float)y + halfHeight));
+}
+
+// grows the run in column x to the right for as long as every column has all
+// of it, taking it out of those columns. returns the width.
+inline int GrowBGMRun(std::span<uint64_t> map, size_t x, uint64_t mask,
+                      int width) {
+    while ((x + width) < map.size() && (map[x + width] & mask) == mask) {
+        // we want to remove these bits from the mask as we go.
+        map[x + width] ^= mask;
+        width++;
+    }
+    return width;
+}
+} // namespace Utils
+
+// Processes a 2D binary mask where each column is a uint64_t, into quads
 // bitArray: span of columns, each a uint64_t mask (1 = solid/opaque, 0 =
 // air) LSB is bottom, so bottom left would be LSB of first column, top right is
 // MSB of last column
-inline std::vector<BGMQuad>
-BinaryGreedyMesh(std::span<const uint64_t> bitArray) {
-    std::vector<BGMQuad> quads;
-    if (bitArray.empty())
-        return quads;
-
-    // copy bits as we destroy as we go.
-    std::vector<uint64_t> map(bitArray.begin(), bitArray.end());
+//
+// Dirty-column mode: if quads already holds the last mesh of the same array,
+// and nothing left of firstDirtyColumn has changed since, pass the first
+// changed column. Quads that end before it are kept as they are, quads that
+// reach into it are grown again, and only the columns from there on are
+// meshed, which gives exactly what meshing the whole array would. Otherwise
+// quads is cleared and everything is meshed.
+//
+// quads keeps its memory between calls, so remeshing doesn't allocate.
+inline void BinaryGreedyMesh(std::span<const uint64_t> bitArray,
+                             std::vector<BGMQuad> &quads,
+                             size_t firstDirtyColumn = 0) {
     const size_t columns = bitArray.size();
-    const size_t bitLength = 64;
+    if (firstDirtyColumn == 0)
+        quads.clear();
+    if (columns == 0)
+        return;
+
+    // copy bits as we destroy as we go. only the columns we mesh are read.
+    thread_local std::vector<uint64_t> s_Map;
+    s_Map.assign(bitArray.begin(), bitArray.end());
+    std::span<uint64_t> map(s_Map);
+
+    // the quads come out column by column, so the ones that start before
+    // the dirty columns are all at the front. those that reach the dirty
+    // columns started the same way, but may grow differently now.
+    const int dirty = (int)std::min(firstDirtyColumn, columns);
+    size_t kept = 0;
+    while (kept < quads.size() && quads[kept].Left() < dirty) {
+        BGMQuad &quad = quads[kept++];
+        int x = quad.Left();
+        int width = quad.Width();
+        if (x + width < dirty)
+            continue; // stopped before the dirty columns, so nothing changed
+
+        uint64_t mask = (~(uint64_t)0 >> (64 - quad.Height()))
+                        << quad.Bottom();
+        width = Utils::GrowBGMRun(map, x, mask, dirty - x);
+        quad = Utils::MakeBGMQuad(x, quad.Bottom(), width, quad.Height());
+    }
+    quads.erase(quads.begin() + kept, quads.end());
 
     // iterate over each column, iterate over each continuous set of bits, and
     // grow vertically then horizontally.
-    for (int x = 0; x < columns; x++) {
+    for (size_t x = dirty; x < columns; x++) {
         while (map[x] != 0) // iterate while we still have bits in this column
         {
             // how many 0's there are at the beginning of the int.
             // this is basically the starting index of the first 1.
             int zero_count = std::countr_zero(map[x]);
+            // and how many 1's follow them, the height of the run.
+            int height = std::countr_one(map[x] >> zero_count);
 
-            // iterate to find how many continuous 1's there are
-            uint64_t mask = map[x] >> zero_count;
-            int height = 0;
-            while ((mask & 1) == 1) {
-                height++;
-                mask >>= 1;
-            }
-            // now, height is how many bits we have in a run, and zero_count is
-            // the start index. in order to isolate the bits of this run, i can
-            // bit shift the remaining bits above away.
-            int invRunLength = bitLength - (zero_count + height);
-            mask = map[x] << invRunLength;
-            mask >>= invRunLength;
-            // mask is now only the bits we want!
+            // isolate the bits of this run, and take them out of the column
+            uint64_t mask = (~(uint64_t)0 >> (64 - height)) << zero_count;
             map[x] ^= mask;
-            int width = 1;
-            while ((x + width) < columns && (map[x + width] & mask) == mask) {
-                // we want to remove these bits from the mask as we go.
-                map[x + width] ^= mask;
-                width++;
-            }
+            int width = Utils::GrowBGMRun(map, x, mask, 1);
             // we have width & height!
-            float halfWidth = (float)width / 2.0f;
-            float halfHeight = (float)height / 2.0f;
-            quads.push_back(BGMQuad(halfWidth, halfHeight,
-                                    glm::vec2((float)x + halfWidth,
-                                              (float)zero_count + halfHeight)));
+            quads.push_back(Utils::MakeBGMQuad((int)x, zero_count, width,
+                                               height));
         }
     }
+}
 
+inline std::vector<BGMQuad>
+BinaryGreedyMesh(std::span<const uint64_t> bitArray) {
+    std::vector<BGMQuad> quads;
+    BinaryGreedyMesh(bitArray, quads);
     return quads;
 }
 
+// Brings shapes, made one per quad from the last mesh, in line with the new
+// quads. removeShape(shape) is called for every quad that is gone, and
+// addShape(quad) for every new one, returning its shape. Quads in both
+// meshes keep their shape, so a small change to the mask only touches the
+// shapes around it. Afterwards shapes lines up with quads. Returns true if
+// any shape was removed or added.
+template <typename Shape, typename RemoveFunc, typename AddFunc>
+bool UpdateBGMShapes(const std::vector<BGMQuad> &previousQuads,
+                     const std::vector<BGMQuad> &quads,
+                     std::vector<Shape> &shapes, RemoveFunc &&removeShape,
+                     AddFunc &&addShape) {
+    // quads of one mesh never overlap, so where they start and how big they
+    // are is enough to tell them apart
+    auto key = [](const BGMQuad &quad) {
+        return ((uint64_t)(uint16_t)quad.Left() << 48) |
+               ((uint64_t)(uint16_t)quad.Bottom() << 32) |
+               ((uint64_t)(uint16_t)quad.Width() << 16) |
+               (uint64_t)(uint16_t)quad.Height();
+    };
+
+    thread_local std::unordered_map<uint64_t, size_t> s_Previous;
+    thread_local std::vector<bool> s_Kept;
+    thread_local std::vector<bool> s_Added;
+    thread_local std::vector<Shape> s_Shapes;
+    s_Previous.clear();
+    for (size_t i = 0; i < previousQuads.size(); i++) {
+        s_Previous[key(previousQuads[i])] = i;
+    }
+    s_Kept.assign(previousQuads.size(), false);
+    s_Added.assign(quads.size(), false);
+
+    s_Shapes.clear();
+    s_Shapes.reserve(quads.size());
+    for (size_t i = 0; i < quads.size(); i++) {
+        auto it = s_Previous.find(key(quads[i]));
+        if (it != s_Previous.end()) {
+            s_Kept[it->second] = true;
+            s_Shapes.push_back(shapes[it->second]);
+        } else {
+            s_Added[i] = true;
+            s_Shapes.push_back(Shape());
+        }
+    }
+
+    // take the old ones away before adding, in mesh order either way
+    bool changed = false;
+    for (size_t i = 0; i < previousQuads.size(); i++) {
+        if (!s_Kept[i]) {
+            removeShape(shapes[i]);
+            changed = true;
+        }
+    }
+    for (size_t i = 0; i < quads.size(); i++) {
+        if (s_Added[i]) {
+            s_Shapes[i] = addShape(quads[i]);
+            changed = true;
+        }
+    }
+    shapes.swap(s_Shapes);
+    return changed;
+}
+
 inline std::vector<BGMQuad>
 BinaryGreedyMeshAI(std::span<const uint64_t> bitArray) {
     std::vector<BGMQuad> quads;
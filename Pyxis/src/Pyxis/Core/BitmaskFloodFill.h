@@ -0,0 +1,165 @@
+#pragma once
+#include <Pyxis/Core/Core.h>
+#include <bit>
+#include <vector>
+
+namespace Pyxis {
+
+// A 2D binary mask stored column by column, like the bit arrays
+// BinaryGreedyMesh takes, but of any height. Each column is wordsPerColumn
+// uint64_t words, word w holding rows 64w to 64w + 63, LSB at the bottom.
+struct ColumnBitmask {
+  public:
+    int width = 0;
+    int height = 0;
+    int wordsPerColumn = 0;
+    std::vector<uint64_t> words;
+
+    ColumnBitmask() {}
+    ColumnBitmask(int maskWidth, int maskHeight)
+        : width(maskWidth), height(maskHeight),
+          wordsPerColumn(((maskHeight - 1) / 64) + 1),
+          words(size_t(maskWidth) * wordsPerColumn, 0) {}
+
+    inline uint64_t &Word(int x, int word) {
+        return words[x * wordsPerColumn + word];
+    }
+    inline uint64_t Word(int x, int word) const {
+        return words[x * wordsPerColumn + word];
+    }
+
+    inline bool Get(glm::ivec2 pos) const {
+        if (pos.x < 0 || pos.y < 0 || pos.x >= width || pos.y >= height)
+            return false;
+        return (Word(pos.x, pos.y / 64) >> (pos.y % 64)) & 1;
+    }
+    inline void Set(glm::ivec2 pos) {
+        Word(pos.x, pos.y / 64) |= (uint64_t)1 << (pos.y % 64);
+    }
+
+    // calls func(pos) for every set bit, column by column, bottom to top
+    template <typename Func> void ForEach(Func &&func) const {
+        for (int x = 0; x < width; x++) {
+            for (int word = 0; word < wordsPerColumn; word++) {
+                uint64_t bits = Word(x, word);
+                while (bits) {
+                    func(glm::ivec2(x, word * 64 + std::countr_zero(bits)));
+                    bits &= bits - 1;
+                }
+            }
+        }
+    }
+};
+
+namespace Utils {
+inline uint64_t ReverseBits(uint64_t v) {
+    v = ((v >> 1) & 0x5555555555555555ull) | ((v & 0x5555555555555555ull) << 1);
+    v = ((v >> 2) & 0x3333333333333333ull) | ((v & 0x3333333333333333ull) << 2);
+    v = ((v >> 4) & 0x0F0F0F0F0F0F0F0Full) | ((v & 0x0F0F0F0F0F0F0F0Full) << 4);
+    v = ((v >> 8) & 0x00FF00FF00FF00FFull) | ((v & 0x00FF00FF00FF00FFull) << 8);
+    v = ((v >> 16) & 0x0000FFFF0000FFFFull) |
+        ((v & 0x0000FFFF0000FFFFull) << 16);
+    return (v >> 32) | (v << 32);
+}
+
+// every bit of mask in the same vertical run as a bit of seeds. seeds has to
+// be inside mask.
+//
+// adding the seeds to the mask starts a carry at each seed that runs up to
+// the top of its run, so the carries are the run above the seed. the run
+// below is the same thing done upside down.
+inline uint64_t FillRuns(uint64_t mask, uint64_t seeds) {
+    uint64_t up = seeds | (mask & ((mask + seeds) ^ mask ^ seeds));
+    uint64_t reversedMask = ReverseBits(mask);
+    uint64_t reversedUp = ReverseBits(up);
+    uint64_t down =
+        reversedUp |
+        (reversedMask & ((reversedMask + reversedUp) ^ reversedMask ^
+                         reversedUp));
+    return ReverseBits(down);
+}
+} // namespace Utils
+
+// Takes the 4-connected region of mask holding start out of mask, and
+// returns it in region, which has to be empty and the same size as mask.
+//
+// Whole columns are filled a word at a time, and only spread sideways into
+// columns where they reach new bits, so no pixel is ever visited on its own.
+// Returns the range of columns the region covers.
+inline glm::ivec2 FloodFillPull(ColumnBitmask &mask, ColumnBitmask &region,
+                                glm::ivec2 start,
+                                std::vector<int> &columnStack) {
+    region.Set(start);
+    glm::ivec2 columns = {start.x, start.x};
+    columnStack.clear();
+    columnStack.push_back(start.x);
+
+    while (!columnStack.empty()) {
+        int x = columnStack.back();
+        columnStack.pop_back();
+        columns = {std::min(columns.x, x), std::max(columns.y, x)};
+
+        // grow the column along its runs, carrying across the words from
+        // the bottom up, then from the top down. bits the region already
+        // took out of the mask still count as part of the runs.
+        for (int word = 0; word < mask.wordsPerColumn; word++) {
+            uint64_t open = mask.Word(x, word) | region.Word(x, word);
+            uint64_t seeds = region.Word(x, word);
+            if (word > 0 && (region.Word(x, word - 1) >> 63))
+                seeds |= open & 1;
+            region.Word(x, word) = Utils::FillRuns(open, seeds);
+        }
+        for (int word = mask.wordsPerColumn - 2; word >= 0; word--) {
+            uint64_t open = mask.Word(x, word) | region.Word(x, word);
+            uint64_t seeds = region.Word(x, word);
+            if (region.Word(x, word + 1) & 1)
+                seeds |= open & ((uint64_t)1 << 63);
+            region.Word(x, word) = Utils::FillRuns(open, seeds);
+        }
+
+        // take it out of the mask, and seed the columns beside it
+        for (int word = 0; word < mask.wordsPerColumn; word++) {
+            uint64_t bits = region.Word(x, word);
+            mask.Word(x, word) &= ~bits;
+            for (int side : {x - 1, x + 1}) {
+                if (side < 0 || side >= mask.width)
+                    continue;
+                uint64_t seeds = bits & mask.Word(side, word) &
+                                 ~region.Word(side, word);
+                if (seeds) {
+                    region.Word(side, word) |= seeds;
+                    columnStack.push_back(side);
+                }
+            }
+        }
+    }
+    return columns;
+}
+
+// Calls func(region) for each 4-connected region of mask, in the order of
+// their lowest leftmost bit. mask ends up empty. The region mask is reused
+// between calls, so copy out whatever is needed from it.
+template <typename Func>
+void ForEachConnectedRegion(ColumnBitmask &mask, Func &&func) {
+    ColumnBitmask region(mask.width, mask.height);
+    std::vector<int> columnStack;
+    for (int x = 0; x < mask.width; x++) {
+        for (int word = 0; word < mask.wordsPerColumn; word++) {
+            while (uint64_t bits = mask.Word(x, word)) {
+                glm::ivec2 start = {x, word * 64 + std::countr_zero(bits)};
+                glm::ivec2 columns =
+                    FloodFillPull(mask, region, start, columnStack);
+                func(static_cast<const ColumnBitmask &>(region));
+
+                // only the columns the region reached need clearing
+                std::fill(region.words.begin() +
+                              size_t(columns.x) * region.wordsPerColumn,
+                          region.words.begin() +
+                              size_t(columns.y + 1) * region.wordsPerColumn,
+                          0);
+            }
+        }
+    }
+}
+
+} // namespace Pyxis
@@ -108,6 +108,8 @@ void PhysicsBody2D::CopyToWorld(b2WorldId worldId) {
     m_B2BodyId = b2CreateBody(worldId, &m_B2BodyDefinition);
 }
 
+bool PhysicsBody2D::IsValid() const { return b2Body_IsValid(m_B2BodyId); }
+
 // main wrapper funcs for body interaction
 void PhysicsBody2D::SetType(PhysicsBody2DType type) {}
 PhysicsBody2DType PhysicsBody2D::GetType() const {
@@ -131,6 +133,13 @@ void PhysicsBody2D::SetAwake(bool awake) {
     b2Body_SetBullet(m_B2BodyId, awake);
 }
 bool PhysicsBody2D::GetAwake() { return b2Body_IsAwake(m_B2BodyId); }
+void PhysicsBody2D::SetEnabled(bool enabled) {
+    if (enabled)
+        b2Body_Enable(m_B2BodyId);
+    else
+        b2Body_Disable(m_B2BodyId);
+}
+bool PhysicsBody2D::IsEnabled() const { return b2Body_IsEnabled(m_B2BodyId); }
 void PhysicsBody2D::SetPosition(const glm::vec2 &position) {
     b2Body_SetTransform(m_B2BodyId, {position.x, position.y},
                         b2Body_GetRotation(m_B2BodyId));
@@ -196,16 +205,24 @@ void PhysicsBody2D::RemoveShapes() {
     b2Body_ApplyMassFromShapes(m_B2BodyId);
 }
 
-void PhysicsBody2D::AddBoxShape(float halfWidth, float halfHeight,
-                                const glm::vec2 &center, float radians = 0) {
+void PhysicsBody2D::RemoveShape(b2ShapeId shape, bool updateMass) {
+    if (b2Shape_IsValid(shape))
+        b2DestroyShape(shape, updateMass);
+}
+
+b2ShapeId PhysicsBody2D::AddBoxShape(float halfWidth, float halfHeight,
+                                     const glm::vec2 &center,
+                                     float radians = 0) {
     b2Polygon poly = b2MakeOffsetBox(
         halfWidth, halfHeight, b2Vec2(center.x, center.y), b2MakeRot(radians));
     b2ShapeDef shapeDef = b2DefaultShapeDef();
     shapeDef.density = (halfWidth * 2) * (halfHeight * 2);
     shapeDef.material.friction = 0.3f;
-    b2CreatePolygonShape(m_B2BodyId, &shapeDef, &poly);
+    return b2CreatePolygonShape(m_B2BodyId, &shapeDef, &poly);
 }
 
+void PhysicsBody2D::UpdateMass() { b2Body_ApplyMassFromShapes(m_B2BodyId); }
+
 void PhysicsBody2D::UpdateBodyDefinition() {
     // wipe all body info first
     m_B2BodyDefinition = b2DefaultBodyDef();
@@ -217,6 +234,7 @@ void PhysicsBody2D::UpdateBodyDefinition() {
     m_B2BodyDefinition.rotation = b2Body_GetRotation(m_B2BodyId);
     m_B2BodyDefinition.angularVelocity = b2Body_GetAngularVelocity(m_B2BodyId);
     m_B2BodyDefinition.angularDamping = b2Body_GetAngularDamping(m_B2BodyId);
+    m_B2BodyDefinition.isEnabled = b2Body_IsEnabled(m_B2BodyId);
 }
 
 void PhysicsBody2D::Serialize(json &j) {
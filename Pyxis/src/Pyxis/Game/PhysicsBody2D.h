@@ -35,6 +35,10 @@ struct PhysicsBody2D {
     // doesn't remove from the prior world!
     void CopyToWorld(b2WorldId worldId);
 
+    // false once the world the body lived in has been destroyed, like after
+    // Physics2D::ClearWorld
+    bool IsValid() const;
+
     // main wrapper funcs for body interaction
     void SetType(PhysicsBody2DType type);
     PhysicsBody2DType GetType() const;
@@ -42,6 +46,10 @@ struct PhysicsBody2D {
     void SetAwake(bool awake);
     bool GetAwake();
 
+    // a disabled body stays in the world, but is left out of the simulation
+    void SetEnabled(bool enabled);
+    bool IsEnabled() const;
+
     void SetPosition(const glm::vec2 &position);
     glm::vec2 GetPosition() const;
 
@@ -67,8 +75,12 @@ struct PhysicsBody2D {
 
     // shapes
     void RemoveShapes();
-    void AddBoxShape(float halfwidth, float halfheight, const glm::vec2 &center,
-                     float radians);
+    // leaves the mass as it was unless told otherwise, so many shapes can be
+    // removed before one UpdateMass
+    void RemoveShape(b2ShapeId shape, bool updateMass = false);
+    b2ShapeId AddBoxShape(float halfwidth, float halfheight,
+                          const glm::vec2 &center, float radians);
+    void UpdateMass();
 
     // Serialization
     void Serialize(json &j);
@@ -56,6 +56,7 @@ namespace Pyxis
 			//Currently Connecting
 			m_ConnectionStatusMessage = "Connecting";
 			m_ConnectionStatus = Connecting;
+			StartNetworkThread();
 			return true;
 		}
 
@@ -100,6 +101,7 @@ namespace Pyxis
 			//Currently Connecting
 			m_ConnectionStatusMessage = "Connecting";
 			m_ConnectionStatus = Connecting;
+			StartNetworkThread();
 			return true;
 		}
 
@@ -129,6 +131,7 @@ namespace Pyxis
 			//Currently Connecting
 			m_ConnectionStatusMessage = "Connecting";
 			m_ConnectionStatus = Connecting;
+			StartNetworkThread();
 			return true;
 		}
 
@@ -145,6 +148,9 @@ namespace Pyxis
 		
 		void ClientInterface::Disconnect()
 		{
+			// hand whatever is still queued to steam first
+			m_NetworkIOThread.Stop();
+
 			//Only disconnect if we are connected
 			if (m_ConnectionStatus != ConnectionStatus::Connected)
 			{
@@ -191,86 +197,42 @@ namespace Pyxis
 
 		void ClientInterface::SendMessageToServer(Message& message)
 		{
-			/*message << message.header.id;
-			m_SteamNetworkingSockets->SendMessageToConnection(m_hConnection, message.body.data(), (uint32)message.size(), k_nSteamNetworkingSend_Reliable, nullptr);*/
-
-			message << message.header.id;
-
-			std::string inString(message.body.begin(), message.body.end());
-			std::string compressedString;
-			snappy::Compress(inString.data(), inString.size(), &compressedString);
-
-
-			Network::Message compressedMsg;
-			compressedMsg.PushData(compressedString.data(), compressedString.size());
-			m_SteamNetworkingSockets->SendMessageToConnection(m_hConnection, compressedMsg.body.data(), (uint32)compressedMsg.size(), k_nSteamNetworkingSend_Reliable, nullptr);
+			SendToServer(message, k_nSteamNetworkingSend_Reliable);
 		}
 
 		void ClientInterface::SendCompressedMessageToServer(Message& message)
 		{
-			message << message.header.id;
-			
-			std::string inString(message.body.begin(), message.body.end());
-			std::string compressedString;
-			snappy::Compress(inString.data(), inString.size(), &compressedString);
-
-
-			Network::Message compressedMsg;
-			compressedMsg.PushData(compressedString.data(), compressedString.size());
-			m_SteamNetworkingSockets->SendMessageToConnection(m_hConnection, compressedMsg.body.data(), (uint32)compressedMsg.size(), k_nSteamNetworkingSend_Reliable, nullptr);
+			SendToServer(message, k_nSteamNetworkingSend_Reliable);
 		}
 
 		void ClientInterface::SendUnreliableMessageToServer(Message& message)
 		{
-			message << message.header.id;
-			m_SteamNetworkingSockets->SendMessageToConnection(m_hConnection, message.body.data(), (uint32)message.size(), k_nSteamNetworkingSend_Unreliable, nullptr);
+			SendToServer(message, k_nSteamNetworkingSend_Unreliable);
 		}
 
-		bool ClientInterface::PollMessage(Ref<Message>& MessageOut)
+		void ClientInterface::SendToServer(Message& message, int nSendFlags)
 		{
-			
-			/*ISteamNetworkingMessage* pIncomingMsg = nullptr;
-			int numMsgs = m_SteamNetworkingSockets->ReceiveMessagesOnConnection(m_hConnection, &pIncomingMsg, 1);
-			if (numMsgs == 0) return false;
-			if (numMsgs < 0)
-			{
-				PX_CORE_ERROR("Error checking for messages");
-				return false;
-			}
-			assert(numMsgs == 1 && pIncomingMsg);
-
-			MessageOut = CreateRef<Message>(pIncomingMsg->m_pData, pIncomingMsg->m_cbSize);
-			*MessageOut >> MessageOut->header.id;
-			MessageOut->clientHConnection = k_HSteamNetConnection_Invalid;
-			pIncomingMsg->Release();
-			return true;*/
-			ISteamNetworkingMessage* pIncomingMsg = nullptr;
-			int numMsgs = m_SteamNetworkingSockets->ReceiveMessagesOnConnection(m_hConnection, &pIncomingMsg, 1);
-			if (numMsgs == 0) return false;
-			if (numMsgs < 0)
-			{
-				PX_CORE_ERROR("Error checking for messages");
-				return false;
-			}
-			assert(numMsgs == 1 && pIncomingMsg);
-
-			// '\0'-terminate it to make it easier to parse
-			std::string stringCompressed;
-			stringCompressed.assign((const char*)pIncomingMsg->m_pData, pIncomingMsg->m_cbSize);
+			Ref<std::string> payload = CreateRef<std::string>();
+			message.Compressed(*payload);
+			m_NetworkIOThread.Send(m_hConnection, payload, nSendFlags);
+		}
 
+		void ClientInterface::StartNetworkThread()
+		{
+			// the thread keeps its own copy of the connection, since ours is
+			// reset on the game thread when the connection closes
+			HSteamNetConnection connection = m_hConnection;
+			m_NetworkIOThread.Start(m_SteamNetworkingSockets, m_SteamNetworkingUtils,
+				[this, connection](SteamNetworkingMessage_t** messagesOut, int maxMessages)
+				{
+					return m_SteamNetworkingSockets->ReceiveMessagesOnConnection(connection, messagesOut, maxMessages);
+				});
+		}
 
-			std::string uncompressed;
-			if (!snappy::Uncompress(stringCompressed.data(), stringCompressed.size(), &uncompressed))
-			{
-				//message failed to uncompress!
-				PX_CORE_ERROR("Message failed to uncompress!");
-			}
-			MessageOut = CreateRef<Message>(uncompressed.data(), uncompressed.size());
-			*MessageOut >> MessageOut->header.id;
-			MessageOut->clientHConnection = pIncomingMsg->m_conn;
-			pIncomingMsg->Release();
-			return true;
-	
+		bool ClientInterface::PollMessage(Message*& MessageOut)
+		{
+			MessageOut = m_NetworkIOThread.Poll();
+			return MessageOut != nullptr;
 		}
 
 		
@@ -332,6 +294,7 @@ namespace Pyxis
 				// to finish up.  The reason information do not matter in this case,
 				// and we cannot linger because it's already closed on the other end,
 				// so we just pass 0's.
+				m_NetworkIOThread.Stop();
 				m_SteamNetworkingSockets->CloseConnection(pInfo->m_hConn, 0, nullptr, false);
 				m_hConnection = k_HSteamNetConnection_Invalid;
 
@@ -4,6 +4,7 @@
 #include <steam/isteamnetworkingutils.h>
 #include <steam/steamnetworkingtypes.h>
 
+#include "NetworkIOThread.h"
 #include "NetworkMessage.h"
 #include "NetworkThreadSafeQueue.h"
 
@@ -43,7 +44,7 @@ namespace Pyxis
 
 			/// <summary>
 			/// Main update loop for the client interface.
-			/// Polls messages and connection changes.
+			/// Polls connection changes, messages are sent and received on the network thread.
 			/// </summary>
 			void UpdateInterface();
 
@@ -74,10 +75,21 @@ namespace Pyxis
 			inline static ClientInterface* s_pCallbackInstance = nullptr;
 			
 			/// <summary>
-			/// Grabs a message and returns true if there was one.
-			/// Create a message to fill with Ref<Network::Message> msg;
+			/// Grabs a message received by the network thread and returns true if there was one.
+			/// The message is only valid until the next call.
+			/// Create a pointer to fill with Network::Message* msg;
 			/// </summary>
-			bool PollMessage(Ref<Message>& MessageOut);
+			bool PollMessage(Message*& MessageOut);
+
+			/// <summary>
+			/// Starts the network thread for the connection we just opened
+			/// </summary>
+			void StartNetworkThread();
+
+			/// <summary>
+			/// Compresses the message and queues it for the network thread
+			/// </summary>
+			void SendToServer(Message& message, int nSendFlags);
 
 			/// <summary>
 			/// Function that will delegate connection changes
@@ -123,6 +135,9 @@ namespace Pyxis
 			ISteamNetworkingSockets* m_SteamNetworkingSockets;
 			ISteamNetworkingUtils* m_SteamNetworkingUtils;
 
+			//sends and receives every message off the game thread
+			NetworkIOThread m_NetworkIOThread;
+
 		};
 		//uint64_t m_ID = 0;
 
@@ -0,0 +1,171 @@
+#include "pxpch.h"
+
+#include "NetworkIOThread.h"
+
+namespace Pyxis
+{
+	namespace Network
+	{
+		NetworkIOThread::~NetworkIOThread()
+		{
+			Stop();
+		}
+
+		void NetworkIOThread::Start(ISteamNetworkingSockets* sockets, ISteamNetworkingUtils* utils, ReceiveFunction receive)
+		{
+			Stop();
+			m_SteamNetworkingSockets = sockets;
+			m_SteamNetworkingUtils = utils;
+			m_Receive = std::move(receive);
+
+			// nothing from an old connection should leak into the new one
+			m_Inbound.Clear();
+			m_Outbound.Clear();
+			m_Overflow.clear();
+			m_HoldingInbound = false;
+
+			m_Stopping = false;
+			m_Thread = std::thread(&NetworkIOThread::ThreadLoop, this);
+		}
+
+		void NetworkIOThread::Stop()
+		{
+			if (!m_Thread.joinable())
+				return;
+			m_Stopping = true;
+			m_Thread.join();
+
+			// the thread emptied the ring on its way out, so whatever overflowed
+			// is all that is left, and still in order
+			for (auto& outgoing : m_Overflow)
+			{
+				m_OutgoingMessages.push_back(CreateOutgoingMessage(outgoing));
+			}
+			m_Overflow.clear();
+			if (!m_OutgoingMessages.empty())
+			{
+				m_SteamNetworkingSockets->SendMessages((int)m_OutgoingMessages.size(), m_OutgoingMessages.data(), nullptr);
+				m_OutgoingMessages.clear();
+			}
+		}
+
+		void NetworkIOThread::Send(HSteamNetConnection conn, const Ref<std::string>& payload, int nSendFlags)
+		{
+			if (!IsRunning())
+				return;
+			FlushOverflow();
+			OutgoingPayload outgoing{ conn, payload, nSendFlags };
+			if (!m_Overflow.empty() || !m_Outbound.TryPush(std::move(outgoing)))
+				m_Overflow.push_back(std::move(outgoing));
+		}
+
+		Message* NetworkIOThread::Poll()
+		{
+			// the last message we handed out is done with now
+			if (m_HoldingInbound)
+			{
+				m_Inbound.Pop();
+				m_HoldingInbound = false;
+			}
+			FlushOverflow();
+
+			Message* message = m_Inbound.Front();
+			m_HoldingInbound = message != nullptr;
+			return message;
+		}
+
+		void NetworkIOThread::ThreadLoop()
+		{
+			while (true)
+			{
+				bool stopping = m_Stopping;
+				bool busy = SendQueued();
+				if (stopping)
+					return;
+				busy |= ReceiveBatch();
+
+				// nothing to do, so give the core back for a moment
+				if (!busy)
+					std::this_thread::sleep_for(std::chrono::milliseconds(1));
+			}
+		}
+
+		bool NetworkIOThread::SendQueued()
+		{
+			OutgoingPayload outgoing;
+			while (m_Outbound.TryPop(outgoing))
+			{
+				m_OutgoingMessages.push_back(CreateOutgoingMessage(outgoing));
+			}
+			if (m_OutgoingMessages.empty())
+				return false;
+
+			//steam takes ownership of the messages, and releases them itself
+			m_SteamNetworkingSockets->SendMessages((int)m_OutgoingMessages.size(), m_OutgoingMessages.data(), nullptr);
+			m_OutgoingMessages.clear();
+			return true;
+		}
+
+		bool NetworkIOThread::ReceiveBatch()
+		{
+			// never take more from steam than there is room for, the rest can
+			// wait there until the game catches up
+			int space = (int)std::min<size_t>(m_Inbound.FreeSlots(), MaxMessagesPerPoll);
+			if (space == 0)
+				return false;
+
+			int numMsgs = m_Receive(m_IncomingMessages.data(), space);
+			if (numMsgs == 0) return false;
+			if (numMsgs < 0)
+			{
+				PX_CORE_ERROR("Error checking for messages");
+				return false;
+			}
+
+			for (int i = 0; i < numMsgs; i++)
+			{
+				SteamNetworkingMessage_t* pIncomingMsg = m_IncomingMessages[i];
+
+				// uncompress straight from the steam buffer into the ring's
+				// message, reusing its storage from the last time around
+				Message* message = m_Inbound.BeginWrite();
+				if (message->Decompress(pIncomingMsg->m_pData, pIncomingMsg->m_cbSize))
+				{
+					message->clientHConnection = pIncomingMsg->m_conn;
+					m_Inbound.EndWrite();
+				}
+				else
+				{
+					PX_CORE_ERROR("Message failed to uncompress!");
+				}
+				pIncomingMsg->Release();
+			}
+			return true;
+		}
+
+		void NetworkIOThread::FlushOverflow()
+		{
+			while (!m_Overflow.empty() && m_Outbound.TryPush(std::move(m_Overflow.front())))
+			{
+				m_Overflow.pop_front();
+			}
+		}
+
+		SteamNetworkingMessage_t* NetworkIOThread::CreateOutgoingMessage(const OutgoingPayload& outgoing)
+		{
+			//no buffer of its own, it points into the payload, and holds a
+			//reference to it that is dropped once steam frees the message
+			SteamNetworkingMessage_t* message = m_SteamNetworkingUtils->AllocateMessage(0);
+			message->m_conn = outgoing.m_Connection;
+			message->m_nFlags = outgoing.m_SendFlags;
+			message->m_pData = outgoing.m_Payload->data();
+			message->m_cbSize = (int)outgoing.m_Payload->size();
+			message->m_nUserData = reinterpret_cast<int64>(new Ref<std::string>(outgoing.m_Payload));
+			message->m_pfnFreeData = [](SteamNetworkingMessage_t* pMsg)
+			{
+				delete reinterpret_cast<Ref<std::string>*>(pMsg->m_nUserData);
+			};
+			return message;
+		}
+	}
+}
@@ -0,0 +1,92 @@
+#pragma once
+#include <array>
+#include <atomic>
+#include <deque>
+#include <functional>
+#include <thread>
+#include <steam/isteamnetworkingsockets.h>
+#include <steam/isteamnetworkingutils.h>
+#include "NetworkMessage.h"
+#include "NetworkRingBuffer.h"
+#include <Pyxis/Core/Log.h>
+
+namespace Pyxis
+{
+	namespace Network
+	{
+		/// <summary>
+		/// Moves messages between steam and the game on a thread of its own.
+		///
+		/// The game thread queues compressed payloads to send and polls received
+		/// messages, each through a lock free ring, so it never waits on the
+		/// sockets. The network thread sends whatever is queued, receives in
+		/// batches, and decompresses straight into the ring's messages.
+		/// Connection changes stay on the game thread, since they call back into
+		/// game code.
+		/// </summary>
+		class NetworkIOThread
+		{
+		public:
+			//most messages pulled from steam in one call
+			static constexpr int MaxMessagesPerPoll = 64;
+			static constexpr size_t InboundCapacity = 1024;
+			static constexpr size_t OutboundCapacity = 4096;
+
+			//pulls up to the given number of messages from steam, returning how
+			//many it got, or a negative number on error
+			using ReceiveFunction = std::function<int(SteamNetworkingMessage_t**, int)>;
+
+			NetworkIOThread() = default;
+			~NetworkIOThread();
+			NetworkIOThread(const NetworkIOThread&) = delete;
+			NetworkIOThread& operator=(const NetworkIOThread&) = delete;
+
+			void Start(ISteamNetworkingSockets* sockets, ISteamNetworkingUtils* utils, ReceiveFunction receive);
+			//sends everything still queued, then stops the thread
+			void Stop();
+			inline bool IsRunning() const { return m_Thread.joinable(); }
+
+			//game thread: queues the payload, which is shared with steam rather
+			//than copied
+			void Send(HSteamNetConnection conn, const Ref<std::string>& payload, int nSendFlags);
+			//game thread: the next received message, valid until the next call
+			Message* Poll();
+
+		private:
+			struct OutgoingPayload
+			{
+				HSteamNetConnection m_Connection = k_HSteamNetConnection_Invalid;
+				Ref<std::string> m_Payload;
+				int m_SendFlags = 0;
+			};
+
+			void ThreadLoop();
+			//returns true if anything was sent or received
+			bool SendQueued();
+			bool ReceiveBatch();
+			//moves payloads that didn't fit in the ring into it, in order
+			void FlushOverflow();
+			//wraps the payload in a steam message that keeps it alive until sent
+			SteamNetworkingMessage_t* CreateOutgoingMessage(const OutgoingPayload& outgoing);
+
+			ISteamNetworkingSockets* m_SteamNetworkingSockets = nullptr;
+			ISteamNetworkingUtils* m_SteamNetworkingUtils = nullptr;
+			ReceiveFunction m_Receive;
+
+			std::thread m_Thread;
+			std::atomic<bool> m_Stopping = false;
+
+			RingBuffer<Message, InboundCapacity> m_Inbound;
+			RingBuffer<OutgoingPayload, OutboundCapacity> m_Outbound;
+			//game thread only. holds sends while the ring is full, so they
+			//still go out in order without the game thread waiting
+			std::deque<OutgoingPayload> m_Overflow;
+			//whether the game thread still holds the front inbound message
+			bool m_HoldingInbound = false;
+
+			//network thread only, reused between batches
+			std::array<SteamNetworkingMessage_t*, MaxMessagesPerPoll> m_IncomingMessages;
+			std::vector<SteamNetworkingMessage_t*> m_OutgoingMessages;
+		};
+	}
+}
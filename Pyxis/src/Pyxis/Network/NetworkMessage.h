@@ -37,11 +37,43 @@ struct Message {
     Message(uint32_t headerID) { header.id = headerID; }
 
     Message(const std::string &compressedStr) {
-        std::string uncompressed;
-        snappy::Uncompress(compressedStr.data(), compressedStr.size(),
-                           &uncompressed);
-        PushData(uncompressed.data(), uncompressed.size());
+        Decompress(compressedStr.data(), compressedStr.size());
+    }
+
+    /// <summary>
+    /// Replaces the body with the uncompressed data, written straight into
+    /// the body's storage, and pulls the header ID off the end. Works
+    /// directly on a received ISteamNetworkingMessage's buffer.
+    /// </summary>
+    /// <returns>false if the data wasn't a valid compressed message</returns>
+    bool Decompress(const void *data, size_t size) {
+        const char *compressed = static_cast<const char *>(data);
+        size_t uncompressedSize;
+        if (!snappy::GetUncompressedLength(compressed, size,
+                                           &uncompressedSize) ||
+            uncompressedSize < sizeof(header.id)) {
+            body.clear();
+            header.size = 0;
+            return false;
+        }
+        body.resize(uncompressedSize);
+        if (!snappy::RawUncompress(compressed, size,
+                                   reinterpret_cast<char *>(body.data()))) {
+            body.clear();
+            header.size = 0;
+            return false;
+        }
+        header.size = body.size();
         *this >> header.id;
+        return true;
+    }
+
+    /// <summary>
+    /// Reserves room for at least this many more bytes, so a message that is
+    /// about to be filled doesn't reallocate as it grows
+    /// </summary>
+    void Reserve(size_t additionalBytes) {
+        body.reserve(body.size() + additionalBytes);
     }
 
     /// <summary>
@@ -52,8 +84,13 @@ struct Message {
     void Compressed(std::string &compressedStrOut) {
         *this << header.id;
 
-        std::string inString(body.begin(), body.end());
-        snappy::Compress(inString.data(), inString.size(), &compressedStrOut);
+        // compress straight out of the body
+        compressedStrOut.resize(snappy::MaxCompressedLength(body.size()));
+        size_t compressedSize;
+        snappy::RawCompress(reinterpret_cast<const char *>(body.data()),
+                            body.size(), compressedStrOut.data(),
+                            &compressedSize);
+        compressedStrOut.resize(compressedSize);
         // we need to pull the ID out so it doesn't mess with the message
         // unintentionally.
         uint32_t revertID;
@@ -157,6 +194,7 @@ struct Message {
             std::is_standard_layout<DataType>::value,
             "Data is too complex to be pushed into message body vector");
 
+        msg.Reserve(data.size() * sizeof(DataType) + sizeof(uint32_t));
         for (auto it = data.rbegin(); it != data.rend(); it++) {
             msg << *it;
         }
@@ -208,6 +246,7 @@ struct Message {
         // get the amount of items to extract
         uint32_t itemCount = 0;
         msg >> itemCount;
+        data.reserve(itemCount);
 
         // loop over that many elements and pull them out
         for (int i = 0; i < itemCount; i++) {
@@ -0,0 +1,98 @@
+#pragma once
+#include <atomic>
+#include <vector>
+
+namespace Pyxis
+{
+	namespace Network
+	{
+		/// <summary>
+		/// A fixed size, lock free queue for exactly one producer thread and one
+		/// consumer thread.
+		///
+		/// Slots are written and read in place and never freed, so whatever
+		/// storage a slot owns (like a message body) is reused as the ring
+		/// wraps around.
+		/// </summary>
+		template<typename T, size_t Capacity>
+		class RingBuffer
+		{
+			static_assert((Capacity & (Capacity - 1)) == 0, "RingBuffer capacity must be a power of two");
+
+		public:
+			RingBuffer() : m_Slots(Capacity) {}
+			RingBuffer(const RingBuffer&) = delete;
+			RingBuffer& operator=(const RingBuffer&) = delete;
+
+			//producer: the next free slot to fill, or nullptr if full
+			T* BeginWrite()
+			{
+				size_t write = m_Write.load(std::memory_order_relaxed);
+				if (write - m_Read.load(std::memory_order_acquire) == Capacity)
+					return nullptr;
+				return &m_Slots[write & (Capacity - 1)];
+			}
+
+			//producer: publishes the slot from BeginWrite to the consumer
+			void EndWrite()
+			{
+				m_Write.store(m_Write.load(std::memory_order_relaxed) + 1, std::memory_order_release);
+			}
+
+			//producer
+			bool TryPush(T&& item)
+			{
+				T* slot = BeginWrite();
+				if (slot == nullptr)
+					return false;
+				*slot = std::move(item);
+				EndWrite();
+				return true;
+			}
+
+			//producer: how many slots can be written right now
+			size_t FreeSlots() const
+			{
+				return Capacity - (m_Write.load(std::memory_order_relaxed) - m_Read.load(std::memory_order_acquire));
+			}
+
+			//consumer: the oldest published slot, or nullptr if empty
+			T* Front()
+			{
+				size_t read = m_Read.load(std::memory_order_relaxed);
+				if (read == m_Write.load(std::memory_order_acquire))
+					return nullptr;
+				return &m_Slots[read & (Capacity - 1)];
+			}
+
+			//consumer: hands the slot from Front back to the producer
+			void Pop()
+			{
+				m_Read.store(m_Read.load(std::memory_order_relaxed) + 1, std::memory_order_release);
+			}
+
+			//consumer
+			bool TryPop(T& itemOut)
+			{
+				T* slot = Front();
+				if (slot == nullptr)
+					return false;
+				itemOut = std::move(*slot);
+				Pop();
+				return true;
+			}
+
+			//only safe while neither side is running
+			void Clear()
+			{
+				m_Read.store(m_Write.load(std::memory_order_relaxed), std::memory_order_relaxed);
+			}
+
+		private:
+			std::vector<T> m_Slots;
+			//kept on separate cache lines so the two threads don't fight over them
+			alignas(64) std::atomic<size_t> m_Write = 0;
+			alignas(64) std::atomic<size_t> m_Read = 0;
+		};
+	}
+}
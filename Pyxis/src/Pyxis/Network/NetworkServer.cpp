@@ -49,6 +49,7 @@ namespace Pyxis
 				return false;
 			}
 			PX_INFO("Steam Server listening on port {0}", m_hLocalAddress.m_port);
+			StartNetworkThread();
 			return true;
 		}
 
@@ -76,15 +77,23 @@ namespace Pyxis
 				return false;
 			}
 			PX_INFO("Steam Server listening on port {0}", m_hLocalAddress.m_port);
+			StartNetworkThread();
 			return true;
 			return false;
 		}
 
 		void ServerInterface::UpdateInterface()
 		{
-			//PollIncomingMessages();
 			PollConnectionStateChanges();
-			std::this_thread::sleep_for(std::chrono::milliseconds(10));
+		}
+
+		void ServerInterface::StartNetworkThread()
+		{
+			m_NetworkIOThread.Start(m_SteamNetworkingSockets, m_SteamNetworkingUtils,
+				[this](SteamNetworkingMessage_t** messagesOut, int maxMessages)
+				{
+					return m_SteamNetworkingSockets->ReceiveMessagesOnPollGroup(m_PollGroup, messagesOut, maxMessages);
+				});
 		}
 
 		
@@ -99,7 +108,13 @@ namespace Pyxis
 				// that's usually best left for more diagnostic/debug text not actual
 				// protocol strings.
 				SendStringToClient(client, "Server is shutting down.  Goodbye.");
+			}
+
+			// hand everything still queued to steam before closing
+			m_NetworkIOThread.Stop();
 
+			for (auto& client : m_ClientsSet)
+			{
 				// Close the connection.  We use "linger mode" to ask SteamNetworkingSockets
 				// to flush this out and close gracefully.
 				m_SteamNetworkingSockets->CloseConnection(client, 0, "Server Shutdown", true);
@@ -134,68 +149,51 @@ namespace Pyxis
 
 		void ServerInterface::SendMessageToClient(HSteamNetConnection conn, Message& message, int nSendFlags)
 		{
-			//std::string inString(message.body.begin(), message.body.end());
-			std::string compressedStr;
-			message.Compressed(compressedStr);
-			if ((uint32_t)compressedStr.size() > k_cbMaxSteamNetworkingSocketsMessageSizeSend)
-			{
-				PX_TRACE("Message sent was too big! [{0}] > [{1}]", (uint32_t)compressedStr.size(), k_cbMaxSteamNetworkingSocketsMessageSizeSend);
-			}
-			m_SteamNetworkingSockets->SendMessageToConnection(conn, compressedStr.data(), (uint32)compressedStr.size(), nSendFlags, nullptr);
+			SendPayloadToClient(conn, CreatePayload(message), nSendFlags);
 		}
 
 		void ServerInterface::SendMessageToAllClients(Message& message, HSteamNetConnection except, int nSendFlags)
 		{
+			SendPayloadToAllClients(CreatePayload(message), except, nSendFlags);
+		}
 
-			std::string compressedStr;
-			message.Compressed(compressedStr);
-			if ((uint32_t)compressedStr.size() > k_cbMaxSteamNetworkingSocketsMessageSizeSend)
-			{
-				PX_TRACE("Message sent was too big! [{0}] > [{1}]", (uint32_t)compressedStr.size(), k_cbMaxSteamNetworkingSocketsMessageSizeSend);
-			}
-
-			for (auto& c : m_ClientsSet)
+		Ref<std::string> ServerInterface::CreatePayload(Message& message)
+		{
+			Ref<std::string> payload = CreateRef<std::string>();
+			message.Compressed(*payload);
+			if ((uint32_t)payload->size() > k_cbMaxSteamNetworkingSocketsMessageSizeSend)
 			{
-				if (c != except)
-					m_SteamNetworkingSockets->SendMessageToConnection(c, compressedStr.data(), (uint32)compressedStr.size(), nSendFlags, nullptr);
+				PX_TRACE("Message sent was too big! [{0}] > [{1}]", (uint32_t)payload->size(), k_cbMaxSteamNetworkingSocketsMessageSizeSend);
 			}
+			return payload;
 		}
 
-		void ServerInterface::SendCompressedStringToClient(HSteamNetConnection conn, std::string& compressedStr, int nSendFlags)
+		void ServerInterface::SendPayloadToClient(HSteamNetConnection conn, const Ref<std::string>& payload, int nSendFlags)
 		{
-			m_SteamNetworkingSockets->SendMessageToConnection(conn, compressedStr.data(), (uint32)compressedStr.size(), k_nSteamNetworkingSend_Reliable, nullptr);
+			m_NetworkIOThread.Send(conn, payload, nSendFlags);
 		}
 
-		void ServerInterface::SendCompressedStringToAllClients(std::string& compressedStr, HSteamNetConnection except, int nSendFlags)
+		void ServerInterface::SendPayloadsToClient(HSteamNetConnection conn, const std::vector<Ref<std::string>>& payloads, int nSendFlags)
 		{
-			for (auto& c : m_ClientsSet)
+			for (auto& payload : payloads)
 			{
-				if (c != except)
-					m_SteamNetworkingSockets->SendMessageToConnection(c, compressedStr.data(), (uint32)compressedStr.size(), nSendFlags, nullptr);
+				m_NetworkIOThread.Send(conn, payload, nSendFlags);
 			}
 		}
 
-		bool ServerInterface::PollMessage(Ref<Message>& MessageOut)
+		void ServerInterface::SendPayloadToAllClients(const Ref<std::string>& payload, HSteamNetConnection except, int nSendFlags)
 		{
-			ISteamNetworkingMessage* pIncomingMsg = nullptr;
-			int numMsgs = m_SteamNetworkingSockets->ReceiveMessagesOnPollGroup(m_PollGroup, &pIncomingMsg, 1);
-			if (numMsgs == 0) return false;
-			if (numMsgs < 0)
+			for (auto& c : m_ClientsSet)
 			{
-				PX_CORE_ERROR("Error checking for messages");
-				return false;
+				if (c != except)
+					m_NetworkIOThread.Send(c, payload, nSendFlags);
 			}
-			assert(numMsgs == 1 && pIncomingMsg);
-			PX_CORE_ASSERT(m_ClientsSet.contains(pIncomingMsg->m_conn), "Message was from unknown client");
-
-			// '\0'-terminate it to make it easier to parse
-			std::string stringCompressed;
-			stringCompressed.assign((const char*)pIncomingMsg->m_pData, pIncomingMsg->m_cbSize);
-			MessageOut = CreateRef<Message>(stringCompressed);
-			MessageOut->clientHConnection = pIncomingMsg->m_conn;
-			pIncomingMsg->Release();
+		}
 
-			return true;
+		bool ServerInterface::PollMessage(Message*& MessageOut)
+		{
+			MessageOut = m_NetworkIOThread.Poll();
+			return MessageOut != nullptr;
 		}
 
 		
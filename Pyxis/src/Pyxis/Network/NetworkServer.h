@@ -3,6 +3,7 @@
 //#include "NetworkThreadSafeQueue.h"
 #include <steam/isteamnetworkingsockets.h>
 #include <steam/isteamnetworkingutils.h>
+#include "NetworkIOThread.h"
 #include "NetworkMessage.h"
 #include <Pyxis/Core/Log.h>
 
@@ -44,7 +45,8 @@ namespace Pyxis
 
 
 			/// <summary>
-			/// The main update loop for the server. It polls incoming messages, connection changes, and waits
+			/// The main update loop for the server. It polls connection changes, messages are
+			/// sent and received on the network thread
 			/// </summary>
 			void UpdateInterface();
 
@@ -59,11 +61,20 @@ namespace Pyxis
 			void SendMessageToClient(HSteamNetConnection conn, Message& message, int nSendFlags = k_nSteamNetworkingSend_Reliable);
 			//k_nSteamNetworkingSend_
 			void SendMessageToAllClients(Message& message, HSteamNetConnection except = k_HSteamNetConnection_Invalid, int nSendFlags = k_nSteamNetworkingSend_Reliable);
+			//compresses the message once into a payload that can be sent, stored,
+			//and sent again without touching the message
+			Ref<std::string> CreatePayload(Message& message);
+			//payloads are shared with steam rather than copied, so one compressed
+			//message can go to every client
 			//k_nSteamNetworkingSend_
-			void SendCompressedStringToClient(HSteamNetConnection conn, std::string& compressedStr, int nSendFlags = k_nSteamNetworkingSend_Reliable);
+			void SendPayloadToClient(HSteamNetConnection conn, const Ref<std::string>& payload, int nSendFlags = k_nSteamNetworkingSend_Reliable);
 			//k_nSteamNetworkingSend_
-			void SendCompressedStringToAllClients(std::string& compressedStr, HSteamNetConnection except = k_HSteamNetConnection_Invalid, int nSendFlags = k_nSteamNetworkingSend_Reliable);
-			bool PollMessage(Ref<Message>& MessageOut);
+			void SendPayloadsToClient(HSteamNetConnection conn, const std::vector<Ref<std::string>>& payloads, int nSendFlags = k_nSteamNetworkingSend_Reliable);
+			//k_nSteamNetworkingSend_
+			void SendPayloadToAllClients(const Ref<std::string>& payload, HSteamNetConnection except = k_HSteamNetConnection_Invalid, int nSendFlags = k_nSteamNetworkingSend_Reliable);
+			//hands out the next message received by the network thread. the
+			//message is only valid until the next call
+			bool PollMessage(Message*& MessageOut);
 			
 			void OnSteamNetConnectionStatusChanged(SteamNetConnectionStatusChangedCallback_t* pInfo);
 			static void SteamNetConnectionStatusChangedCallback(SteamNetConnectionStatusChangedCallback_t* pInfo);
@@ -74,6 +85,9 @@ namespace Pyxis
 			
 
 		protected:
+			//starts the network thread once we are listening
+			void StartNetworkThread();
+
 			//called when a client connects to the server
 			virtual bool OnClientConnect(HSteamNetConnection& client);
 			//called when a client appears to have disconnected
@@ -93,6 +107,9 @@ namespace Pyxis
 			ISteamNetworkingSockets* m_SteamNetworkingSockets;
 			ISteamNetworkingUtils* m_SteamNetworkingUtils;
 
+			//sends and receives every message off the game thread
+			NetworkIOThread m_NetworkIOThread;
+
 			//thread safe queue for incoming message packets
 			//ThreadSafeQueue<OwnedMessage<T>> m_QueueMessagesIn;
 
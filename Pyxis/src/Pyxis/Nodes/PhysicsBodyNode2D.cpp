@@ -133,9 +133,16 @@ float PhysicsBodyNode2D::GetAngularDamping() {
 
 void PhysicsBodyNode2D::RemoveShapes() { m_PhysicsBody->RemoveShapes(); }
 
-void PhysicsBodyNode2D::AddBoxShape(float halfWidth, float halfHeight,
-                                    const glm::vec2 &center, float radians) {
-    m_PhysicsBody->AddBoxShape(halfWidth, halfHeight, center, radians);
+void PhysicsBodyNode2D::RemoveShape(b2ShapeId shape, bool updateMass) {
+    m_PhysicsBody->RemoveShape(shape, updateMass);
 }
 
+b2ShapeId PhysicsBodyNode2D::AddBoxShape(float halfWidth, float halfHeight,
+                                         const glm::vec2 &center,
+                                         float radians) {
+    return m_PhysicsBody->AddBoxShape(halfWidth, halfHeight, center, radians);
+}
+
+void PhysicsBodyNode2D::UpdateMass() { m_PhysicsBody->UpdateMass(); }
+
 } // namespace Pyxis
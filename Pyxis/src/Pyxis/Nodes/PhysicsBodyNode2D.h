@@ -68,8 +68,10 @@ class PhysicsBodyNode2D : public Node2D {
 
     // shape funcs
     void RemoveShapes();
-    void AddBoxShape(float halfWidth, float halfHeight, const glm::vec2 &center,
-                     float radians);
+    void RemoveShape(b2ShapeId shape, bool updateMass = false);
+    b2ShapeId AddBoxShape(float halfWidth, float halfHeight,
+                          const glm::vec2 &center, float radians);
+    void UpdateMass();
 };
 
 REGISTER_SERIALIZABLE_NODE(PhysicsBodyNode2D);